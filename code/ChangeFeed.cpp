@@ -0,0 +1,308 @@
+#include "ChangeFeed.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+
+
+// Random non-zero identifier so cursors saved by a previous process are recognised as foreign
+static uint64_t makeEpoch() {
+    std::random_device device;
+    uint64_t epoch = (static_cast<uint64_t>(device()) << 32) ^ device() ^
+                     static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return epoch ? epoch : 1;
+}
+
+ChangeFeed::ChangeFeed(LMS& lms, size_t capacity) : lms(lms), feedEpoch(makeEpoch()), head(0) {
+    size_t rounded = 1;
+    while (rounded < capacity) rounded <<= 1;
+    mask = rounded - 1;
+
+    slots.reset(new Slot[rounded]);
+    for (size_t i = 0; i < rounded; ++i) {
+        slots[i].version.store(0, std::memory_order_relaxed);
+    }
+    lms.addObserver(this);
+}
+
+ChangeFeed::~ChangeFeed() {
+    lms.removeObserver(this);
+}
+
+uint64_t ChangeFeed::epoch() const {
+    return feedEpoch;
+}
+
+size_t ChangeFeed::capacity() const {
+    return mask + 1;
+}
+
+uint64_t ChangeFeed::latestSequence() const {
+    return head.load(std::memory_order_acquire);
+}
+
+uint64_t ChangeFeed::oldestSequence() const {
+    uint64_t latest = latestSequence();
+    return latest > capacity() ? latest - capacity() + 1 : 1;
+}
+
+
+// Inline slot layout: the header word holds the type (bits 0-7), the payload length (8-15), the
+// spilled flag (16) and the year (32-63). The payload holds the string fields below, each as a
+// length byte followed by its bytes, then the number of days and each day in the same form.
+static std::string ChangeEvent::* const encodedFields[] = {
+    &ChangeEvent::key, &ChangeEvent::courseCode, &ChangeEvent::firstName, &ChangeEvent::lastName,
+    &ChangeEvent::courseName, &ChangeEvent::instructor, &ChangeEvent::startTime, &ChangeEvent::endTime
+};
+
+// Encode event into out; false if it does not fit in kMaxPayload bytes
+static bool encodeEvent(const ChangeEvent& event, char* out, size_t& length) {
+    size_t position = 0;
+    auto put = [&](const std::string& text) {
+        if (position + 1 + text.size() > ChangeFeed::kMaxPayload) return false;
+        out[position++] = static_cast<char>(text.size());
+        std::memcpy(out + position, text.data(), text.size());
+        position += text.size();
+        return true;
+    };
+    for (std::string ChangeEvent::* field : encodedFields) {
+        if (!put(event.*field)) return false;
+    }
+    if (position + 1 > ChangeFeed::kMaxPayload || event.daysOfWeek.size() > 0xff) return false;
+    out[position++] = static_cast<char>(event.daysOfWeek.size());
+    for (const std::string& day : event.daysOfWeek) {
+        if (!put(day)) return false;
+    }
+    length = position;
+    return true;
+}
+
+// Decode the fields written by encodeEvent; bounds are checked against length throughout
+static void decodeEvent(const char* bytes, size_t length, ChangeEvent& event) {
+    size_t position = 0;
+    auto get = [&](std::string& text) {
+        size_t size = position < length ? static_cast<unsigned char>(bytes[position++]) : 0;
+        size = std::min(size, length - position);
+        text.assign(bytes + position, size);
+        position += size;
+    };
+    for (std::string ChangeEvent::* field : encodedFields) {
+        get(event.*field);
+    }
+    size_t days = position < length ? static_cast<unsigned char>(bytes[position++]) : 0;
+    event.daysOfWeek.resize(days);
+    for (std::string& day : event.daysOfWeek) {
+        get(day);
+    }
+}
+
+// Write one event into its slot; only ever called from the thread mutating the LMS
+void ChangeFeed::publish(ChangeEvent event) {
+    const uint64_t sequence = head.load(std::memory_order_relaxed) + 1;
+    Slot& slot = slots[sequence & mask];
+    event.sequence = sequence;
+
+    // Events too large for the slot are stored whole in the side table instead of being cut
+    uint64_t words[kPayloadWords] = {};
+    size_t length = 0;
+    const bool spill = !encodeEvent(event, reinterpret_cast<char*>(words), length);
+    const uint64_t type = static_cast<uint8_t>(event.type);
+    const uint64_t year = spill ? 0 : static_cast<uint32_t>(event.year);
+    if (spill) {
+        length = 0;
+        std::fill(std::begin(words), std::end(words), 0);
+        std::lock_guard<std::mutex> lock(spillMutex);
+        while (!spilled.empty() && spilled.begin()->first + capacity() <= sequence) {
+            spilled.erase(spilled.begin());
+        }
+        spilled[sequence] = std::move(event);
+    }
+
+    slot.version.store(2 * sequence - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.header.store(type | (length << 8) |
+                      (static_cast<uint64_t>(spill) << 16) | (year << 32), std::memory_order_relaxed);
+    for (size_t i = 0; i < kPayloadWords; ++i) {
+        slot.payload[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.version.store(2 * sequence, std::memory_order_release);
+    head.store(sequence, std::memory_order_release);
+}
+
+// Copy event `sequence` out of its slot; false if the slot has since been reused
+bool ChangeFeed::readSlot(uint64_t sequence, ChangeEvent& event) const {
+    const Slot& slot = slots[sequence & mask];
+
+    uint64_t before = slot.version.load(std::memory_order_acquire);
+    if (before != 2 * sequence) {
+        return false;
+    }
+    uint64_t header = slot.header.load(std::memory_order_relaxed);
+    uint64_t words[kPayloadWords];
+    for (size_t i = 0; i < kPayloadWords; ++i) {
+        words[i] = slot.payload[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.version.load(std::memory_order_relaxed) != before) {
+        return false;
+    }
+
+    if ((header >> 16) & 1) {
+        // Validated above, so an entry for this sequence is this event; a missing one means it was evicted
+        std::lock_guard<std::mutex> lock(spillMutex);
+        auto it = spilled.find(sequence);
+        if (it == spilled.end()) {
+            return false;
+        }
+        event = it->second;
+        return true;
+    }
+    event.sequence = sequence;
+    event.type = static_cast<ChangeType>(header & 0xff);
+    event.year = static_cast<int32_t>(static_cast<uint32_t>(header >> 32));
+    decodeEvent(reinterpret_cast<const char*>(words), std::min<size_t>((header >> 8) & 0xff, kMaxPayload), event);
+    return true;
+}
+
+ChangeFeed::ReadStatus ChangeFeed::read(uint64_t fromSequence, size_t maxBatch, std::vector<ChangeEvent>& out) const {
+    if (fromSequence == 0) fromSequence = 1;
+    const uint64_t latest = latestSequence();
+    if (fromSequence > latest + 1) {
+        // No cursor of this feed can be past the next event; it came from somewhere else
+        return ReadStatus::Reset;
+    }
+    if (fromSequence < oldestSequence()) {
+        return ReadStatus::Lapped;
+    }
+
+    ChangeEvent event;
+    size_t count = 0;
+    for (uint64_t sequence = fromSequence; sequence <= latest && count < maxBatch; ++sequence, ++count) {
+        if (!readSlot(sequence, event)) {
+            // Overwritten while we were reading; whatever was copied before it is still valid
+            return count > 0 ? ReadStatus::Ok : ReadStatus::Lapped;
+        }
+        out.push_back(event);
+    }
+    return ReadStatus::Ok;
+}
+
+
+// Helper functions building the event for an entity or an ID; add events carry the entity's fields
+static ChangeEvent keyEvent(ChangeType type, const std::string& key, const std::string& courseCode = "") {
+    ChangeEvent event{};
+    event.type = type;
+    event.key = key;
+    event.courseCode = courseCode;
+    return event;
+}
+
+static ChangeEvent studentEvent(const Student& student) {
+    ChangeEvent event = keyEvent(ChangeType::StudentAdded, student.getID());
+    event.firstName = student.getFirstName();
+    event.lastName = student.getLastName();
+    event.year = student.getYear();
+    return event;
+}
+
+static ChangeEvent instructorEvent(const Instructor& instructor) {
+    ChangeEvent event = keyEvent(ChangeType::InstructorAdded, instructor.getEmployeeID());
+    event.firstName = instructor.getFirstName();
+    event.lastName = instructor.getLastName();
+    return event;
+}
+
+static ChangeEvent courseEvent(const Course& course) {
+    ChangeEvent event = keyEvent(ChangeType::CourseAdded, course.getCourseCode());
+    event.courseName = course.getCourseName();
+    event.instructor = course.getCourseInstructor();
+    event.daysOfWeek = course.getDaysOfWeek();
+    event.startTime = course.getStartTime();
+    event.endTime = course.getEndTime();
+    return event;
+}
+
+
+// LMSObserver overrides publishing each mutation
+void ChangeFeed::onStudentAdded(const Student& student) {
+    publish(studentEvent(student));
+}
+
+void ChangeFeed::onStudentRemoved(const std::string& netID) {
+    publish(keyEvent(ChangeType::StudentRemoved, netID));
+}
+
+void ChangeFeed::onInstructorAdded(const Instructor& instructor) {
+    publish(instructorEvent(instructor));
+}
+
+void ChangeFeed::onInstructorRemoved(const std::string& empID) {
+    publish(keyEvent(ChangeType::InstructorRemoved, empID));
+}
+
+void ChangeFeed::onCourseAdded(const Course& course) {
+    publish(courseEvent(course));
+}
+
+void ChangeFeed::onCourseRemoved(const std::string& code) {
+    publish(keyEvent(ChangeType::CourseRemoved, code));
+}
+
+void ChangeFeed::onStudentEnrolled(const Student& student, const Course& course) {
+    publish(keyEvent(ChangeType::StudentEnrolled, student.getID(), course.getCourseCode()));
+}
+
+void ChangeFeed::onStudentDropped(const Student& student, const std::string& courseCode) {
+    publish(keyEvent(ChangeType::StudentDropped, student.getID(), courseCode));
+}
+
+// Entities first, in the order they depend on each other, then the enrollments
+ChangeSnapshot ChangeFeed::snapshot() const {
+    ChangeSnapshot snapshot{feedEpoch, latestSequence(), {}};
+    for (const Instructor* instructor : lms.getInstructors()) {
+        snapshot.events.push_back(instructorEvent(*instructor));
+    }
+    for (const Course* course : lms.getCourses()) {
+        snapshot.events.push_back(courseEvent(*course));
+    }
+    for (const Student* student : lms.getStudents()) {
+        snapshot.events.push_back(studentEvent(*student));
+    }
+    for (const Student* student : lms.getStudents()) {
+        for (const std::string& courseCode : student->getEnrolledCourses()) {
+            snapshot.events.push_back(keyEvent(ChangeType::StudentEnrolled, student->getID(), courseCode));
+        }
+    }
+    for (ChangeEvent& event : snapshot.events) {
+        event.sequence = snapshot.sequence;
+    }
+    return snapshot;
+}
+
+
+ChangeSubscription::ChangeSubscription(const ChangeFeed& feed)
+    : feed(feed), next(feed.latestSequence() + 1), epochMatches(true) {
+}
+
+ChangeSubscription::ChangeSubscription(const ChangeFeed& feed, uint64_t epoch, uint64_t resumeSequence)
+    : feed(feed), next(resumeSequence > 0 ? resumeSequence : 1), epochMatches(epoch == feed.epoch()) {
+}
+
+ChangeFeed::ReadStatus ChangeSubscription::poll(std::vector<ChangeEvent>& out, size_t maxBatch) {
+    if (!epochMatches) {
+        return ChangeFeed::ReadStatus::Reset;
+    }
+    size_t before = out.size();
+    ChangeFeed::ReadStatus status = feed.read(next, maxBatch, out);
+    next += out.size() - before;
+    return status;
+}
+
+void ChangeSubscription::resumeFrom(uint64_t sequence) {
+    next = sequence > 0 ? sequence : 1;
+    epochMatches = true;
+}
+
+uint64_t ChangeSubscription::nextSequence() const {
+    return next;
+}
@@ -0,0 +1,166 @@
+// ChangeFeed.h
+
+#ifndef CHANGE_FEED_H
+#define CHANGE_FEED_H
+
+#include "LMS.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+// Kind of mutation recorded in the change feed
+enum class ChangeType : uint8_t {
+    StudentAdded,
+    StudentRemoved,
+    InstructorAdded,
+    InstructorRemoved,
+    CourseAdded,
+    CourseRemoved,
+    StudentEnrolled,
+    StudentDropped
+};
+
+// One entry of the change feed as handed to consumers.
+// key is the NetID, EmployeeID or CourseCode of the entity the event is about;
+// courseCode is only set for StudentEnrolled / StudentDropped.
+// Add events also carry the new entity's fields, so consumers never read them back from the LMS:
+//   StudentAdded     firstName, lastName, year
+//   InstructorAdded  firstName, lastName
+//   CourseAdded      courseName, instructor (EmployeeID), daysOfWeek, startTime, endTime
+struct ChangeEvent {
+    uint64_t sequence;
+    ChangeType type;
+    std::string key;
+    std::string courseCode;
+    std::string firstName;
+    std::string lastName;
+    int year;
+    std::string courseName;
+    std::string instructor;
+    std::vector<std::string> daysOfWeek;
+    std::string startTime;
+    std::string endTime;
+};
+
+// Full state of the LMS as of one sequence of a feed, for consumers that were lapped or reset.
+// events holds an InstructorAdded, CourseAdded or StudentAdded event per entity followed by a
+// StudentEnrolled event per enrollment, all stamped with sequence. Applying them rebuilds the
+// state, and the consumer then continues at sequence + 1 of the feed with this epoch.
+struct ChangeSnapshot {
+    uint64_t epoch;
+    uint64_t sequence;
+    std::vector<ChangeEvent> events;
+};
+
+// Ordered, bounded feed of LMS mutations for downstream consumers.
+// The feed registers itself as an LMSObserver and assigns every mutation a sequence number
+// starting at 1. Events live in a fixed ring of slots that the LMS thread overwrites once the
+// ring wraps; any number of consumer threads read without locks, each tracking its own position.
+// A consumer that falls more than capacity events behind is told it was lapped and must
+// resynchronise from a snapshot() before resuming after it.
+// Sequences restart at 1 with every ChangeFeed, so each feed also has a random epoch; a saved
+// cursor is only meaningful together with the epoch it was read under.
+class ChangeFeed : public LMSObserver {
+public:
+    // Longest encoded event stored inline in a slot, in bytes; larger events go to a side table
+    static constexpr size_t kMaxPayload = 120;
+
+    enum class ReadStatus {
+        Ok,
+        Lapped,     // The requested events were overwritten; resync from a snapshot
+        Reset       // The cursor does not belong to this feed (ahead of it, or another epoch); resync
+    };
+
+    // Constructor to attach the feed to an LMS; capacity is rounded up to a power of two
+    explicit ChangeFeed(LMS& lms, size_t capacity = 4096);
+
+    // Destructor to detach from the LMS
+    ~ChangeFeed() override;
+
+    ChangeFeed(const ChangeFeed&) = delete;
+    ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+    // Append up to maxBatch events with sequence >= fromSequence to out. Safe from any thread.
+    ReadStatus read(uint64_t fromSequence, size_t maxBatch, std::vector<ChangeEvent>& out) const;
+
+    // Copy the current LMS state together with latestSequence(). Must be called on the thread that
+    // mutates the LMS (e.g. on behalf of a consumer that asked for a resync), like drain().
+    ChangeSnapshot snapshot() const;
+
+    // Identifier of this feed instance, to be stored alongside any persisted sequence
+    uint64_t epoch() const;
+
+    // Sequence of the most recent event (0 before the first one)
+    uint64_t latestSequence() const;
+
+    // Oldest sequence still held in the ring
+    uint64_t oldestSequence() const;
+
+    size_t capacity() const;
+
+    // LMSObserver overrides publishing each mutation
+    void onStudentAdded(const Student& student) override;
+    void onStudentRemoved(const std::string& netID) override;
+    void onInstructorAdded(const Instructor& instructor) override;
+    void onInstructorRemoved(const std::string& empID) override;
+    void onCourseAdded(const Course& course) override;
+    void onCourseRemoved(const std::string& code) override;
+    void onStudentEnrolled(const Student& student, const Course& course) override;
+    void onStudentDropped(const Student& student, const std::string& courseCode) override;
+
+private:
+    static constexpr size_t kPayloadWords = kMaxPayload / sizeof(uint64_t);
+
+    // A ring slot guarded by a seqlock: version is 2*seq while event seq is readable and odd while
+    // it is being rewritten. Every field is an atomic word so concurrent reads are well defined.
+    struct Slot {
+        std::atomic<uint64_t> version;
+        std::atomic<uint64_t> header;
+        std::atomic<uint64_t> payload[kPayloadWords];
+    };
+
+    LMS& lms;
+    uint64_t feedEpoch;
+    size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> head;
+
+    // Events too large for a slot, keyed by sequence. Only touched for such events, so the
+    // common path stays lock-free; entries are dropped once their slot is reused.
+    mutable std::mutex spillMutex;
+    std::map<uint64_t, ChangeEvent> spilled;
+
+    // Helper functions to write and read a single slot
+    void publish(ChangeEvent event);
+    bool readSlot(uint64_t sequence, ChangeEvent& event) const;
+};
+
+// Cursor over a ChangeFeed for a single consumer, remembering where it left off
+class ChangeSubscription {
+public:
+    // Constructor to start reading after the latest event
+    explicit ChangeSubscription(const ChangeFeed& feed);
+
+    // Constructor to resume at a sequence saved under the given feed epoch; polls report Reset
+    // if that epoch is not this feed's (e.g. the process restarted)
+    ChangeSubscription(const ChangeFeed& feed, uint64_t epoch, uint64_t resumeSequence);
+
+    // Append the next batch of events to out and advance past them
+    ChangeFeed::ReadStatus poll(std::vector<ChangeEvent>& out, size_t maxBatch = 256);
+
+    // Continue from a sequence of this feed, e.g. snapshot.sequence + 1 after a resync
+    void resumeFrom(uint64_t sequence);
+
+    // Sequence the next poll will start from
+    uint64_t nextSequence() const;
+
+private:
+    const ChangeFeed& feed;
+    uint64_t next;
+    bool epochMatches;
+};
+
+#endif // CHANGE_FEED_H
@@ -0,0 +1,296 @@
+#include "EnrollmentAnalytics.h"
+
+
+namespace {
+
+// Day names as stored in Course::getDaysOfWeek, indexed by their bit in the courseDays mask
+const char* const dayNames[7] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+
+uint8_t dayBit(const std::string& day) {
+    for (int i = 0; i < 7; ++i) {
+        if (day == dayNames[i]) return static_cast<uint8_t>(1u << i);
+    }
+    return 0;
+}
+
+// Count occurrences of each value of column in [0, buckets).
+// Four interleaved partial histograms keep consecutive equal values from serialising on one counter.
+std::vector<uint32_t> histogram(const std::vector<uint32_t>& column, size_t buckets) {
+    std::vector<uint32_t> partial(buckets * 4, 0);
+    uint32_t* p0 = partial.data();
+    uint32_t* p1 = p0 + buckets;
+    uint32_t* p2 = p1 + buckets;
+    uint32_t* p3 = p2 + buckets;
+
+    const uint32_t* values = column.data();
+    const size_t n = column.size();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        ++p0[values[i]];
+        ++p1[values[i + 1]];
+        ++p2[values[i + 2]];
+        ++p3[values[i + 3]];
+    }
+    for (; i < n; ++i) {
+        ++p0[values[i]];
+    }
+
+    std::vector<uint32_t> counts(buckets);
+    for (size_t b = 0; b < buckets; ++b) {
+        counts[b] = p0[b] + p1[b] + p2[b] + p3[b];
+    }
+    return counts;
+}
+
+} // namespace
+
+
+EnrollmentAnalytics::EnrollmentAnalytics(LMS& lms) : lms(lms) {
+    rebuild();
+    lms.addObserver(this);
+}
+
+EnrollmentAnalytics::~EnrollmentAnalytics() {
+    lms.removeObserver(this);
+}
+
+void EnrollmentAnalytics::rebuild() {
+    studentYear.clear();
+    studentAlive.clear();
+    studentIndex.clear();
+    courseCodes.clear();
+    courseTimes.clear();
+    courseInstructor.clear();
+    courseDays.clear();
+    courseAlive.clear();
+    courseIndex.clear();
+    instructorIDs.clear();
+    instructorIndex.clear();
+    enrollStudent.clear();
+    enrollCourse.clear();
+    studentRows.clear();
+
+    for (const Course* course : lms.getCourses()) {
+        onCourseAdded(*course);
+    }
+    for (const Student* student : lms.getStudents()) {
+        uint32_t s = internStudent(*student);
+        for (const std::string& code : student->getEnrolledCourses()) {
+            addEnrollmentRow(s, internCourseCode(code));
+        }
+    }
+}
+
+
+// Helper functions to intern entities into the columns
+uint32_t EnrollmentAnalytics::internStudent(const Student& student) {
+    auto it = studentIndex.find(student.getID());
+    uint32_t index;
+    if (it != studentIndex.end()) {
+        index = it->second;
+    } else {
+        index = static_cast<uint32_t>(studentYear.size());
+        studentIndex.emplace(student.getID(), index);
+        studentYear.push_back(0);
+        studentAlive.push_back(0);
+        studentRows.emplace_back();
+    }
+    studentYear[index] = student.getYear();
+    studentAlive[index] = 1;
+    return index;
+}
+
+// Course codes seen only through enrollments are interned as not alive until the course is added
+uint32_t EnrollmentAnalytics::internCourseCode(const std::string& code) {
+    auto it = courseIndex.find(code);
+    if (it != courseIndex.end()) {
+        return it->second;
+    }
+    uint32_t index = static_cast<uint32_t>(courseCodes.size());
+    courseIndex.emplace(code, index);
+    courseCodes.push_back(code);
+    courseTimes.emplace_back();
+    courseInstructor.push_back(0);
+    courseDays.push_back(0);
+    courseAlive.push_back(0);
+    return index;
+}
+
+uint32_t EnrollmentAnalytics::internInstructor(const std::string& empID) {
+    auto it = instructorIndex.find(empID);
+    if (it != instructorIndex.end()) {
+        return it->second;
+    }
+    uint32_t index = static_cast<uint32_t>(instructorIDs.size());
+    instructorIndex.emplace(empID, index);
+    instructorIDs.push_back(empID);
+    return index;
+}
+
+void EnrollmentAnalytics::setCourseColumns(uint32_t index, const Course& course) {
+    uint8_t days = 0;
+    for (const std::string& day : course.getDaysOfWeek()) {
+        days |= dayBit(day);
+    }
+    courseTimes[index] = course.getStartTime() + "-" + course.getEndTime();
+    courseInstructor[index] = internInstructor(course.getCourseInstructor());
+    courseDays[index] = days;
+    courseAlive[index] = 1;
+}
+
+void EnrollmentAnalytics::addEnrollmentRow(uint32_t student, uint32_t course) {
+    studentRows[student].push_back(static_cast<uint32_t>(enrollStudent.size()));
+    enrollStudent.push_back(student);
+    enrollCourse.push_back(course);
+}
+
+// Order of enrollments is irrelevant to the aggregates, so the last row takes the removed row's place;
+// only the two students involved have their row lists updated
+void EnrollmentAnalytics::removeEnrollmentRow(uint32_t row) {
+    std::vector<uint32_t>& rows = studentRows[enrollStudent[row]];
+    *std::find(rows.begin(), rows.end(), row) = rows.back();
+    rows.pop_back();
+
+    const uint32_t last = static_cast<uint32_t>(enrollStudent.size() - 1);
+    if (row != last) {
+        std::vector<uint32_t>& lastRows = studentRows[enrollStudent[last]];
+        *std::find(lastRows.begin(), lastRows.end(), last) = row;
+        enrollStudent[row] = enrollStudent[last];
+        enrollCourse[row] = enrollCourse[last];
+    }
+    enrollStudent.pop_back();
+    enrollCourse.pop_back();
+}
+
+
+// LMSObserver overrides keeping the columns in sync
+void EnrollmentAnalytics::onStudentAdded(const Student& student) {
+    internStudent(student);
+}
+
+// Removing a student drops each of their enrollment rows
+void EnrollmentAnalytics::onStudentRemoved(const std::string& netID) {
+    auto it = studentIndex.find(netID);
+    if (it == studentIndex.end()) {
+        return;
+    }
+    const uint32_t s = it->second;
+    studentAlive[s] = 0;
+
+    while (!studentRows[s].empty()) {
+        removeEnrollmentRow(studentRows[s].back());
+    }
+}
+
+void EnrollmentAnalytics::onCourseAdded(const Course& course) {
+    setCourseColumns(internCourseCode(course.getCourseCode()), course);
+}
+
+void EnrollmentAnalytics::onCourseRemoved(const std::string& code) {
+    auto it = courseIndex.find(code);
+    if (it != courseIndex.end()) {
+        courseAlive[it->second] = 0;
+    }
+}
+
+void EnrollmentAnalytics::onStudentEnrolled(const Student& student, const Course& course) {
+    uint32_t c = internCourseCode(course.getCourseCode());
+    if (!courseAlive[c]) {
+        setCourseColumns(c, course);
+    }
+    addEnrollmentRow(internStudent(student), c);
+}
+
+void EnrollmentAnalytics::onStudentDropped(const Student& student, const std::string& courseCode) {
+    auto studentIt = studentIndex.find(student.getID());
+    auto courseIt = courseIndex.find(courseCode);
+    if (studentIt == studentIndex.end() || courseIt == courseIndex.end()) {
+        return;
+    }
+    const uint32_t c = courseIt->second;
+    for (uint32_t row : studentRows[studentIt->second]) {
+        if (enrollCourse[row] == c) {
+            removeEnrollmentRow(row);
+            return;
+        }
+    }
+}
+
+
+// Aggregate queries over enrollments in existing courses
+std::vector<uint32_t> EnrollmentAnalytics::enrollmentsPerCourse() const {
+    return histogram(enrollCourse, courseCodes.size());
+}
+
+size_t EnrollmentAnalytics::totalEnrollments() const {
+    std::vector<uint32_t> perCourse = enrollmentsPerCourse();
+    size_t total = 0;
+    for (size_t c = 0; c < perCourse.size(); ++c) {
+        total += perCourse[c] * courseAlive[c];
+    }
+    return total;
+}
+
+std::map<std::string, size_t> EnrollmentAnalytics::countPerCourse() const {
+    std::vector<uint32_t> perCourse = enrollmentsPerCourse();
+    std::map<std::string, size_t> result;
+    for (size_t c = 0; c < perCourse.size(); ++c) {
+        if (courseAlive[c]) {
+            result[courseCodes[c]] = perCourse[c];
+        }
+    }
+    return result;
+}
+
+std::map<std::string, size_t> EnrollmentAnalytics::countPerInstructor() const {
+    std::vector<uint32_t> perCourse = enrollmentsPerCourse();
+    std::vector<size_t> perInstructor(instructorIDs.size(), 0);
+    for (size_t c = 0; c < perCourse.size(); ++c) {
+        if (courseAlive[c]) {
+            perInstructor[courseInstructor[c]] += perCourse[c];
+        }
+    }
+
+    std::map<std::string, size_t> result;
+    for (size_t i = 0; i < perInstructor.size(); ++i) {
+        if (perInstructor[i] > 0) {
+            result[instructorIDs[i]] = perInstructor[i];
+        }
+    }
+    return result;
+}
+
+std::map<int, size_t> EnrollmentAnalytics::countPerYear() const {
+    // Gather the alive flag of each enrollment's course, then fold students into years
+    std::vector<uint32_t> perStudent(studentYear.size(), 0);
+    const uint32_t* students = enrollStudent.data();
+    const uint32_t* coursesColumn = enrollCourse.data();
+    const uint8_t* alive = courseAlive.data();
+    for (size_t e = 0; e < enrollStudent.size(); ++e) {
+        perStudent[students[e]] += alive[coursesColumn[e]];
+    }
+
+    std::map<int, size_t> result;
+    for (size_t s = 0; s < perStudent.size(); ++s) {
+        if (studentAlive[s] && perStudent[s] > 0) {
+            result[studentYear[s]] += perStudent[s];
+        }
+    }
+    return result;
+}
+
+std::map<std::string, size_t> EnrollmentAnalytics::countPerDaySlot() const {
+    std::vector<uint32_t> perCourse = enrollmentsPerCourse();
+    std::map<std::string, size_t> result;
+    for (size_t c = 0; c < perCourse.size(); ++c) {
+        if (!courseAlive[c] || perCourse[c] == 0) {
+            continue;
+        }
+        for (int bit = 0; bit < 7; ++bit) {
+            if (courseDays[c] & (1u << bit)) {
+                result[std::string(dayNames[bit]) + " " + courseTimes[c]] += perCourse[c];
+            }
+        }
+    }
+    return result;
+}
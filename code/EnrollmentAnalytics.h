@@ -0,0 +1,89 @@
+// EnrollmentAnalytics.h
+
+#ifndef ENROLLMENT_ANALYTICS_H
+#define ENROLLMENT_ANALYTICS_H
+
+#include "LMS.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+// Columnar (struct-of-arrays) view of the LMS used for enrollment statistics.
+// Students, courses and instructors are interned to dense integer indices, and every
+// enrollment is stored as a (student index, course index) pair in two parallel columns,
+// so aggregate queries are tight loops over integer arrays instead of string compares.
+// Each student also keeps the list of their enrollment rows, so a drop or a student removal
+// only touches that student's rows instead of scanning every enrollment.
+// The view is built once from the LMS and then kept current through LMSObserver events.
+// Enrollments in courses that no longer exist are kept but not counted, matching printSchedule.
+class EnrollmentAnalytics : public LMSObserver {
+public:
+    // Constructor to build the columns from the current LMS state and start following it
+    explicit EnrollmentAnalytics(LMS& lms);
+
+    // Destructor to stop following the LMS
+    ~EnrollmentAnalytics() override;
+
+    EnrollmentAnalytics(const EnrollmentAnalytics&) = delete;
+    EnrollmentAnalytics& operator=(const EnrollmentAnalytics&) = delete;
+
+    // Discard the columns and rebuild them from the LMS
+    void rebuild();
+
+    // Aggregate queries over enrollments in existing courses
+    size_t totalEnrollments() const;
+    std::map<std::string, size_t> countPerCourse() const;
+    std::map<std::string, size_t> countPerInstructor() const;
+    std::map<int, size_t> countPerYear() const;
+    // Keyed by "<day> <start>-<end>", e.g. "Mon 09:00-10:30"; a course counts once per meeting day
+    std::map<std::string, size_t> countPerDaySlot() const;
+
+    // LMSObserver overrides keeping the columns in sync
+    void onStudentAdded(const Student& student) override;
+    void onStudentRemoved(const std::string& netID) override;
+    void onCourseAdded(const Course& course) override;
+    void onCourseRemoved(const std::string& code) override;
+    void onStudentEnrolled(const Student& student, const Course& course) override;
+    void onStudentDropped(const Student& student, const std::string& courseCode) override;
+
+private:
+    LMS& lms;
+
+    // Student columns
+    std::vector<int32_t> studentYear;
+    std::vector<uint8_t> studentAlive;
+    std::unordered_map<std::string, uint32_t> studentIndex;
+
+    // Course columns; courseDays is a bitmask with bit 0 = Mon ... bit 6 = Sun
+    std::vector<std::string> courseCodes;
+    std::vector<std::string> courseTimes;
+    std::vector<uint32_t> courseInstructor;
+    std::vector<uint8_t> courseDays;
+    std::vector<uint8_t> courseAlive;
+    std::unordered_map<std::string, uint32_t> courseIndex;
+
+    // Instructor dictionary referenced by courseInstructor
+    std::vector<std::string> instructorIDs;
+    std::unordered_map<std::string, uint32_t> instructorIndex;
+
+    // Enrollment columns, and the rows of each student (indexed like studentYear)
+    std::vector<uint32_t> enrollStudent;
+    std::vector<uint32_t> enrollCourse;
+    std::vector<std::vector<uint32_t>> studentRows;
+
+    // Helper functions to intern entities into the columns
+    uint32_t internStudent(const Student& student);
+    uint32_t internCourseCode(const std::string& code);
+    uint32_t internInstructor(const std::string& empID);
+    void setCourseColumns(uint32_t index, const Course& course);
+
+    // Helper functions to append an enrollment row and to swap-remove one
+    void addEnrollmentRow(uint32_t student, uint32_t course);
+    void removeEnrollmentRow(uint32_t row);
+
+    // Number of enrollments per course index, ignoring whether the course still exists
+    std::vector<uint32_t> enrollmentsPerCourse() const;
+};
+
+#endif // ENROLLMENT_ANALYTICS_H
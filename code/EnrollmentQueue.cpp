@@ -0,0 +1,173 @@
+#include "EnrollmentQueue.h"
+
+#include <climits>
+#include <memory>
+
+
+EnrollmentQueue::EnrollmentQueue(LMS& lms, size_t maxPerStudentPerBatch)
+    : lms(lms), maxPerStudentPerBatch(maxPerStudentPerBatch > 0 ? maxPerStudentPerBatch : 1),
+      inbox(nullptr), nextTicket(0), pending(0), maxPending(0), submittedCount(0),
+      completedCount(0), deferredCount(0), batchCount(0) {
+}
+
+EnrollmentQueue::~EnrollmentQueue() {
+    collectInbox();
+    for (auto& entry : studentQueues) {
+        for (Request* request : entry.second.requests) delete request;
+    }
+}
+
+std::future<EnrollmentResult> EnrollmentQueue::submitEnroll(std::string studentID, std::string courseCode,
+                                                            Callback callback) {
+    return submit(EnrollmentAction::Enroll, std::move(studentID), std::move(courseCode), std::move(callback));
+}
+
+std::future<EnrollmentResult> EnrollmentQueue::submitDrop(std::string studentID, std::string courseCode,
+                                                          Callback callback) {
+    return submit(EnrollmentAction::Drop, std::move(studentID), std::move(courseCode), std::move(callback));
+}
+
+// Push a request onto the inbox with a CAS loop; never blocks the caller
+std::future<EnrollmentResult> EnrollmentQueue::submit(EnrollmentAction action, std::string studentID,
+                                                      std::string courseCode, Callback callback) {
+    Request* request = new Request{std::move(studentID), std::move(courseCode), action, std::move(callback), {}, 0, nullptr};
+    std::future<EnrollmentResult> result = request->promise.get_future();
+    request->ticket = nextTicket.fetch_add(1, std::memory_order_relaxed);
+
+    size_t depthNow = pending.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t highWater = maxPending.load(std::memory_order_relaxed);
+    while (depthNow > highWater &&
+           !maxPending.compare_exchange_weak(highWater, depthNow, std::memory_order_relaxed)) {
+    }
+    submittedCount.fetch_add(1, std::memory_order_relaxed);
+
+    request->next = inbox.load(std::memory_order_relaxed);
+    while (!inbox.compare_exchange_weak(request->next, request,
+                                        std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return result;
+}
+
+// Move everything pushed since the last drain into the per-student queues.
+// The inbox is a stack and concurrent pushes may land out of ticket order, so sort the new arrivals first.
+void EnrollmentQueue::collectInbox() {
+    std::vector<Request*> arrivals;
+    for (Request* request = inbox.exchange(nullptr, std::memory_order_acquire); request; request = request->next) {
+        arrivals.push_back(request);
+    }
+    std::sort(arrivals.begin(), arrivals.end(), [](const Request* a, const Request* b) {
+        return a->ticket < b->ticket;
+    });
+
+    for (Request* request : arrivals) {
+        auto it = studentQueues.find(request->studentID);
+        if (it == studentQueues.end()) {
+            Student* student = lms.findStudentByID(request->studentID);
+            int year = student ? student->getYear() : INT_MAX;
+            it = studentQueues.emplace(request->studentID, StudentQueue{request->studentID, year, {}}).first;
+            ready.push(ReadyEntry{year, request->ticket, &it->second});
+        }
+        it->second.requests.push_back(request);
+    }
+}
+
+size_t EnrollmentQueue::drain(size_t maxBatch) {
+    collectInbox();
+
+    // Serve students in priority order, at most maxPerStudentPerBatch requests each;
+    // students with requests left over are re-queued only after the batch so they cannot go twice
+    std::vector<ReadyEntry> heldBack;
+    size_t applied = 0;
+    while (applied < maxBatch && !ready.empty()) {
+        StudentQueue* queue = ready.top().queue;
+        ready.pop();
+
+        for (size_t served = 0; served < maxPerStudentPerBatch && applied < maxBatch && !queue->requests.empty();
+             ++served, ++applied) {
+            Request* request = queue->requests.front();
+            queue->requests.pop_front();
+            complete(request);
+        }
+
+        if (queue->requests.empty()) {
+            // Erase by iterator: the key argument must not alias the element being erased
+            studentQueues.erase(studentQueues.find(queue->studentID));
+        } else {
+            deferredCount.fetch_add(1, std::memory_order_relaxed);
+            heldBack.push_back(ReadyEntry{queue->year, queue->requests.front()->ticket, queue});
+        }
+    }
+    for (const ReadyEntry& entry : heldBack) {
+        ready.push(entry);
+    }
+
+    if (applied > 0) {
+        batchCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return applied;
+}
+
+// Apply one request that has already left the backlog and report the outcome.
+// The future is fulfilled before the callback runs; exceptions from either are contained here
+// so one misbehaving request cannot leave the queue in a broken state.
+void EnrollmentQueue::complete(Request* request) {
+    std::unique_ptr<Request> owned(request);
+    pending.fetch_sub(1, std::memory_order_relaxed);
+    completedCount.fetch_add(1, std::memory_order_relaxed);
+
+    EnrollmentResult result{request->studentID, request->courseCode, request->action, EnrollmentStatus::StudentNotFound};
+    try {
+        result.status = apply(*request);
+    } catch (...) {
+        request->promise.set_exception(std::current_exception());
+        return;
+    }
+
+    request->promise.set_value(result);
+    if (request->callback) {
+        try {
+            request->callback(result);
+        } catch (const std::exception& error) {
+            std::cerr << "Enrollment callback for " << result.studentID << " threw: " << error.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Enrollment callback for " << result.studentID << " threw an unknown exception" << std::endl;
+        }
+    }
+}
+
+// Run a single request against the LMS and classify the outcome
+EnrollmentStatus EnrollmentQueue::apply(const Request& request) {
+    Student* student = lms.findStudentByID(request.studentID);
+    if (!student) {
+        return EnrollmentStatus::StudentNotFound;
+    }
+
+    if (request.action == EnrollmentAction::Drop) {
+        bool wasEnrolled = student->isEnrolledIn(request.courseCode);
+        lms.dropStudent(request.studentID, request.courseCode);
+        return wasEnrolled ? EnrollmentStatus::Dropped : EnrollmentStatus::NotEnrolled;
+    }
+
+    Course* course = lms.findCourseByID(request.courseCode);
+    if (!course) {
+        return EnrollmentStatus::CourseNotFound;
+    }
+    bool wasEnrolled = student->isEnrolledIn(request.courseCode);
+    lms.enrollStudent(*student, *course);
+    return wasEnrolled ? EnrollmentStatus::AlreadyEnrolled : EnrollmentStatus::Enrolled;
+}
+
+size_t EnrollmentQueue::depth() const {
+    return pending.load(std::memory_order_relaxed);
+}
+
+EnrollmentQueueMetrics EnrollmentQueue::getMetrics() const {
+    return EnrollmentQueueMetrics{
+        pending.load(std::memory_order_relaxed),
+        maxPending.load(std::memory_order_relaxed),
+        submittedCount.load(std::memory_order_relaxed),
+        completedCount.load(std::memory_order_relaxed),
+        deferredCount.load(std::memory_order_relaxed),
+        batchCount.load(std::memory_order_relaxed)
+    };
+}
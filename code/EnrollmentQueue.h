@@ -0,0 +1,143 @@
+// EnrollmentQueue.h
+
+#ifndef ENROLLMENT_QUEUE_H
+#define ENROLLMENT_QUEUE_H
+
+#include "LMS.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <queue>
+#include <unordered_map>
+
+// Kind of request placed on the enrollment queue
+enum class EnrollmentAction {
+    Enroll,
+    Drop
+};
+
+// Outcome of a request once it has been applied to the LMS
+enum class EnrollmentStatus {
+    Enrolled,
+    AlreadyEnrolled,
+    Dropped,
+    NotEnrolled,
+    StudentNotFound,
+    CourseNotFound
+};
+
+// Result delivered to the submitter through its future and optional callback
+struct EnrollmentResult {
+    std::string studentID;
+    std::string courseCode;
+    EnrollmentAction action;
+    EnrollmentStatus status;
+};
+
+// Snapshot of the queue counters, safe to read from any thread
+struct EnrollmentQueueMetrics {
+    size_t depth;           // Requests submitted but not yet completed
+    size_t maxDepth;        // High-water mark of depth
+    uint64_t submitted;     // Total requests accepted by submit*
+    uint64_t completed;     // Total requests applied to the LMS
+    uint64_t deferred;      // Times a student with more requests waiting was held back by the per-student limit
+    uint64_t batches;       // Number of drain() calls that applied at least one request
+};
+
+// Asynchronous front end for LMS::enrollStudent / LMS::dropStudent.
+// Any number of threads may submit; submission is a lock-free push onto a shared stack.
+// A single thread (the one that owns the LMS) calls drain() to apply requests in batches,
+// ordered by student year (lowest year first, i.e. senior cohorts) and then by arrival.
+// Each student may have at most maxPerStudentPerBatch requests applied per drain, so early
+// arrivals cannot take every seat in a contended section before others are served.
+class EnrollmentQueue {
+public:
+    using Callback = std::function<void(const EnrollmentResult&)>;
+
+    // Constructor binding the queue to the LMS it will apply requests to
+    explicit EnrollmentQueue(LMS& lms, size_t maxPerStudentPerBatch = 1);
+
+    // Destructor; requests that were never drained leave their futures with a broken promise
+    ~EnrollmentQueue();
+
+    EnrollmentQueue(const EnrollmentQueue&) = delete;
+    EnrollmentQueue& operator=(const EnrollmentQueue&) = delete;
+
+    // Submit requests from any thread
+    std::future<EnrollmentResult> submitEnroll(std::string studentID, std::string courseCode,
+                                               Callback callback = nullptr);
+    std::future<EnrollmentResult> submitDrop(std::string studentID, std::string courseCode,
+                                             Callback callback = nullptr);
+
+    // Apply up to maxBatch queued requests to the LMS; returns how many were applied.
+    // Must only be called from the thread that owns the LMS.
+    size_t drain(size_t maxBatch);
+
+    // Number of requests submitted but not yet completed
+    size_t depth() const;
+
+    // Read the queue counters
+    EnrollmentQueueMetrics getMetrics() const;
+
+private:
+    struct Request {
+        std::string studentID;
+        std::string courseCode;
+        EnrollmentAction action;
+        Callback callback;
+        std::promise<EnrollmentResult> promise;
+        uint64_t ticket;
+        Request* next;
+    };
+
+    // Requests of one student waiting to be applied, oldest first
+    struct StudentQueue {
+        std::string studentID;
+        int year;
+        std::deque<Request*> requests;
+    };
+
+    // Heap entry for a student with waiting requests, keyed on the year and ticket of their oldest request
+    struct ReadyEntry {
+        int year;
+        uint64_t ticket;
+        StudentQueue* queue;
+    };
+    struct LaterEntry {
+        bool operator()(const ReadyEntry& a, const ReadyEntry& b) const {
+            return a.year != b.year ? a.year > b.year : a.ticket > b.ticket;
+        }
+    };
+
+    LMS& lms;
+    size_t maxPerStudentPerBatch;
+
+    // Lock-free MPSC inbox; producers push, drain() takes the whole list at once
+    std::atomic<Request*> inbox;
+    std::atomic<uint64_t> nextTicket;
+
+    // Requests taken from the inbox but not yet applied; only touched by drain() and the destructor.
+    // Every StudentQueue with requests has exactly one entry in ready, so a drain costs
+    // O(applied * log students) however many requests are waiting.
+    std::unordered_map<std::string, StudentQueue> studentQueues;
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, LaterEntry> ready;
+
+    std::atomic<size_t> pending;
+    std::atomic<size_t> maxPending;
+    std::atomic<uint64_t> submittedCount;
+    std::atomic<uint64_t> completedCount;
+    std::atomic<uint64_t> deferredCount;
+    std::atomic<uint64_t> batchCount;
+
+    // Helper functions used by submit* and drain()
+    std::future<EnrollmentResult> submit(EnrollmentAction action, std::string studentID,
+                                         std::string courseCode, Callback callback);
+    void collectInbox();
+    void complete(Request* request);
+    EnrollmentStatus apply(const Request& request);
+};
+
+#endif // ENROLLMENT_QUEUE_H
@@ -1,34 +1,39 @@
 #include "LMS.h"
 
+#include <filesystem>
+#include <unordered_map>
 
-Instructor::Instructor(const std::string& fName, const std::string& lName, const std::string& empID)
-        : firstName(fName), lastName(lName), employeeID(empID) {}
 
-std::string Instructor::getFirstName() const {
+Instructor::Instructor(std::string fName, std::string lName, std::string empID)
+        : firstName(std::move(fName)), lastName(std::move(lName)), employeeID(std::move(empID)),
+          fullName(firstName + " " + lastName) {}
+
+const std::string& Instructor::getFirstName() const {
     return firstName;
 }
 
-std::string Instructor::getLastName() const {
+const std::string& Instructor::getLastName() const {
     return lastName;
 }
 
-std::string Instructor::getFullName() const {
-    return firstName + " " + lastName;
+// The full name is built once in the constructor since Instructor has no setters
+const std::string& Instructor::getFullName() const {
+    return fullName;
 }
 
-std::string Instructor::getEmployeeID() const {
+const std::string& Instructor::getEmployeeID() const {
     return employeeID;
 }
 
 
 
 
-Course::Course(const std::string& code, const std::string& name, const Instructor& instructor,
-               const std::vector<std::string>& daysOfWeek, const std::string& startTime,
-               const std::string& endTime, const std::string& description)
-    : courseCode(code), courseName(name), courseInstructor(instructor.getEmployeeID()),
-      courseDaysOfWeek(daysOfWeek), courseStartTime(startTime), courseEndTime(endTime),
-      courseDescription(description) {
+Course::Course(std::string code, std::string name, const Instructor& instructor,
+               std::vector<std::string> daysOfWeek, std::string startTime,
+               std::string endTime, std::string description)
+    : courseCode(std::move(code)), courseName(std::move(name)), courseInstructor(instructor.getEmployeeID()),
+      courseDaysOfWeek(std::move(daysOfWeek)), courseStartTime(std::move(startTime)), courseEndTime(std::move(endTime)),
+      courseDescription(std::move(description)) {
 }
 
 Course::~Course() {}
@@ -85,11 +90,11 @@ const std::string& Course::getDescription() const {
     }
 
 // Constructor to initialize a Student object
-Student::Student(const std::string& fname, const std::string& lName, int sYear, const std::string& netID)
+Student::Student(std::string fname, std::string lName, int sYear, std::string netID)
         : studentYear(sYear) {
-        firstName = fname;
-        lastName = lName;
-        NetID = netID;
+        firstName = std::move(fname);
+        lastName = std::move(lName);
+        NetID = std::move(netID);
     }
 
 // Display student information in a structured format
@@ -105,14 +110,13 @@ const std::string& Student::getID() const  {
 }
 
 // Check if the student is enrolled in a specific course
-bool Student::isEnrolledIn(const std::string& courseCode) const {
+bool Student::isEnrolledIn(std::string_view courseCode) const {
         return std::find(enrolledCourseCodes.begin(), enrolledCourseCodes.end(), courseCode) != enrolledCourseCodes.end();
     }
 
 // Enroll a student in a specific course
-void Student::enrollIn(const std::string& courseCode) {
-        enrolledCourseCodes.push_back(courseCode);
-        std::cout << "Enrollment in course Success" << std::endl;
+void Student::enrollIn(std::string courseCode) {
+        enrolledCourseCodes.push_back(std::move(courseCode));
     }
 
 // Getter methods for Student attributes
@@ -133,7 +137,7 @@ int Student::getYear() const {
     }
 
 // Drop a student from a specific course
-bool Student::dropCourse(const std::string& courseCode) {
+bool Student::dropCourse(std::string_view courseCode) {
         auto courseIt = std::find(enrolledCourseCodes.begin(), enrolledCourseCodes.end(), courseCode);
         if (courseIt != enrolledCourseCodes.end()) {
             enrolledCourseCodes.erase(courseIt);
@@ -142,7 +146,7 @@ bool Student::dropCourse(const std::string& courseCode) {
         return false; 
     }
 
-Course* LMS::findCourseByCode(const std::string& courseCode) const {
+Course* LMS::findCourseByCode(std::string_view courseCode) const {
     auto it = std::find_if(courses.begin(), courses.end(), [&courseCode](Course* course) {
         return course->getCourseCode() == courseCode;
     });
@@ -151,22 +155,69 @@ Course* LMS::findCourseByCode(const std::string& courseCode) const {
 }
 
 
-LMS::LMS() {
+// Split a CSV line into tokens the way repeated std::getline(ss, token, delimiter) does,
+// reusing the tokens vector across lines instead of building a stringstream per line
+static void splitLine(const std::string& line, char delimiter, std::vector<std::string>& tokens) {
+    tokens.clear();
+    size_t start = 0;
+    while (start < line.size()) {
+        size_t end = line.find(delimiter, start);
+        if (end == std::string::npos) end = line.size();
+        tokens.emplace_back(line, start, end - start);
+        start = end + 1;
+    }
+}
+
+// Parse a student year field the way std::stoi does, reporting failure instead of throwing
+static bool parseYear(const std::string& text, int& year) {
+    try {
+        year = std::stoi(text);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+
+// Path of a CSV file inside a data directory; an empty directory means the working directory
+static std::string dataFilePath(const std::string& dataDirectory, const char* filename) {
+    return (std::filesystem::path(dataDirectory) / filename).string();
+}
+
+
+LMS::LMS() : LMS("") {}
+
+LMS::LMS(const std::string& dataDirectory)
+        : dataDirectory(dataDirectory),
+          studentsFile(dataFilePath(dataDirectory, "students.csv")),
+          instructorsFile(dataFilePath(dataDirectory, "instructors.csv")),
+          coursesFile(dataFilePath(dataDirectory, "courses.csv")),
+          enrollmentsFile(dataFilePath(dataDirectory, "enrollments.csv")) {
+        // Report a missing data directory up front rather than on every save; creating it is left
+        // to the caller (e.g. PartitionedLMS::addShard) so a mistyped path is not silently created
+        std::error_code error;
+        if (!dataDirectory.empty() && !std::filesystem::is_directory(dataDirectory, error)) {
+            std::cerr << "Data directory " << dataDirectory << " does not exist." << std::endl;
+        }
+
         students.reserve(20); 
         instructors.reserve(20);
         courses.reserve(20);
 
         //std::cout << "Before loading students from CSV" << std::endl;
-        loadStudentsFromCSV("students.csv");
+        loadStudentsFromCSV(studentsFile);
         //std::cout << "After loading students from CSV" << std::endl;
 
        // std::cout << "Before loading instructors from CSV" << std::endl;
-        loadInstructorsFromCSV("instructors.csv");
+        loadInstructorsFromCSV(instructorsFile);
         //std::cout << "After loading instructors from CSV" << std::endl;
 
        // std::cout << "Before loading courses from CSV" << std::endl;
-        loadCoursesFromCSV("courses.csv");
+        loadCoursesFromCSV(coursesFile);
         //std::cout << "After loading courses from CSV" << std::endl;
+
+        // Enrollments refer to students by NetID, so they are loaded last
+        loadEnrollmentsFromCSV(enrollmentsFile);
     }
 
     // Destructor to deallocate memory used by dynamically allocated objects
@@ -179,36 +230,41 @@ LMS::~LMS() {
     // Load data from CSV files
 void LMS::loadStudentsFromCSV(const std::string& filename) {
         std::ifstream file(filename);
-        std::string line, token;
+        std::string line;
+        std::vector<std::string> tokens;
         std::getline(file, line);  // Skip the header line
 
         while (std::getline(file, line)) {
-            std::istringstream ss(line);
-            std::vector<std::string> tokens;
+            splitLine(line, ',', tokens);
 
-            while (std::getline(ss, token, ',')) {
-                tokens.push_back(token);
+            int year = 0;
+            if (tokens.size() < 4 || !parseYear(tokens[2], year)) {
+                // Ensure that there are at least FirstName, LastName, Year and NetID, with a numeric year
+                std::cerr << "Invalid CSV line: " << line << std::endl;
+                continue;
             }
 
-            Student* newStudent = new Student(tokens[0], tokens[1], std::stoi(tokens[2]), tokens[3]);
+            Student* newStudent = new Student(std::move(tokens[0]), std::move(tokens[1]), year, std::move(tokens[3]));
             students.push_back(newStudent);
         }
     }
 
 void LMS::loadInstructorsFromCSV(const std::string& filename) {
     std::ifstream file(filename);
-    std::string line, token;
+    std::string line;
+    std::vector<std::string> tokens;
     std::getline(file, line);  // Skip the header line
 
     while (std::getline(file, line)) {
-        std::istringstream ss(line);
-        std::vector<std::string> tokens;
+        splitLine(line, ',', tokens);
 
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(token);
+        if (tokens.size() < 3) {
+            // Ensure that there are at least FirstName, LastName and EmployeeID in the CSV line
+            std::cerr << "Invalid CSV line: " << line << std::endl;
+            continue;
         }
 
-        Instructor* newInstructor = new Instructor(tokens[0], tokens[1], tokens[2]);
+        Instructor* newInstructor = new Instructor(std::move(tokens[0]), std::move(tokens[1]), std::move(tokens[2]));
         instructors.push_back(newInstructor);
         }
     }
@@ -217,15 +273,21 @@ void LMS::loadInstructorsFromCSV(const std::string& filename) {
 
 void LMS::loadCoursesFromCSV(const std::string& filename) {
     std::ifstream file(filename);
-    std::string line, token;
+    std::string line;
+    std::vector<std::string> tokens;
     std::getline(file, line);  // Skip the header line
 
     while (std::getline(file, line)) {
-        std::istringstream ss(line);
-        std::vector<std::string> tokens;
-
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(token);
+        splitLine(line, ',', tokens);
+
+        if (tokens.size() > 7) {
+            // Only the quoted description may contain commas; take it back whole from the rest of the line
+            size_t start = 6;
+            for (size_t i = 0; i < 6; ++i) start += tokens[i].size();
+            tokens[6].assign(line, start, std::string::npos);
+            if (tokens[6].size() >= 2 && tokens[6].front() == '"' && tokens[6].back() == '"') {
+                tokens.resize(7);
+            }
         }
 
         if (tokens.size() != 7) {
@@ -234,35 +296,68 @@ void LMS::loadCoursesFromCSV(const std::string& filename) {
             continue;
         }
 
-        // Extract and assign values to variables
-        std::string code = tokens[0];
-        std::string name = tokens[1];
-        std::string instructorEmpID = tokens[2];
+        // Look up the instructor first so skipped lines cost no further copies
+        const std::string& code = tokens[0];
+        const std::string& instructorEmpID = tokens[2];
+        Instructor* instructor = findInstructorByID(instructorEmpID);
+        if (!instructor) {
+            std::cerr << "Instructor with Employee ID " << instructorEmpID << " not found. Skipping course " << code << std::endl;
+            continue;
+        }
 
         // Parse the days of the week
-        std::string daysOfWeekStr = tokens[3];
-        std::istringstream daysStream(daysOfWeekStr);
         std::vector<std::string> daysOfWeek;
-        while (std::getline(daysStream, token, '&')) {
-            daysOfWeek.push_back(token);
+        splitLine(tokens[3], '&', daysOfWeek);
+
+        // Remove the quotes saveCoursesToCSV puts around the description, in place
+        std::string& description = tokens[6];
+        if (description.size() >= 2 && description.front() == '"' && description.back() == '"') {
+            description.pop_back();
+            description.erase(0, 1);
         }
 
-        std::string startTime = tokens[4];
-        std::string endTime = tokens[5];
+        // Create and add the course, moving the extracted values into it
+        Course* newCourse = new Course(std::move(tokens[0]), std::move(tokens[1]), *instructor, std::move(daysOfWeek),
+                                       std::move(tokens[4]), std::move(tokens[5]), std::move(description));
+        courses.push_back(newCourse);
+    }
+}
 
-        // Remove quotes from the description
-        std::string description = tokens[6];
-        description = description.substr(1, description.size() - 2);
+void LMS::loadEnrollmentsFromCSV(const std::string& filename) {
+    std::ifstream file(filename);
+    std::string line;
+    std::vector<std::string> tokens;
+    std::getline(file, line);  // Skip the header line
+    if (file.peek() == std::ifstream::traits_type::eof()) {
+        return;  // No enrollments (or no file), so there is nothing to index
+    }
 
-        Instructor* instructor = findInstructorByID(instructorEmpID);
-        if (!instructor) {
-            std::cerr << "Instructor with Employee ID " << instructorEmpID << " not found. Skipping course " << code << std::endl;
+    // Index the loaded students once instead of searching the list for every enrollment
+    std::unordered_map<std::string_view, Student*> studentsByID;
+    studentsByID.reserve(students.size());
+    for (Student* student : students) {
+        studentsByID.emplace(student->getID(), student);
+    }
+
+    while (std::getline(file, line)) {
+        splitLine(line, ',', tokens);
+
+        if (tokens.size() < 2) {
+            // Ensure that there are at least NetID and CourseCode in the CSV line
+            std::cerr << "Invalid CSV line: " << line << std::endl;
             continue;
         }
 
-        // Create and add the course with the extracted values
-        Course* newCourse = new Course(code, name, *instructor, daysOfWeek, startTime, endTime, description);
-        courses.push_back(newCourse);
+        auto it = studentsByID.find(tokens[0]);
+        if (it == studentsByID.end()) {
+            std::cerr << "Student with NetID " << tokens[0] << " not found. Skipping enrollment in " << tokens[1] << std::endl;
+            continue;
+        }
+
+        // The course itself is not required: a student keeps a removed course's code, and so does the file
+        if (!it->second->isEnrolledIn(tokens[1])) {
+            it->second->enrollIn(std::move(tokens[1]));
+        }
     }
 }
 
@@ -308,22 +403,37 @@ void LMS::saveCoursesToCSV(const std::string& filename) {
              << course->getCourseName() << "," 
              << course->getCourseInstructor() << ",";
 
-        // This loop writes the days of the week
+        // This loop writes the days of the week, joined with '&' as loadCoursesFromCSV expects
         for (size_t i = 0; i < course->getDaysOfWeek().size(); ++i) {
             file << course->getDaysOfWeek()[i];
             if (i != course->getDaysOfWeek().size() - 1) {
-                file << ",";
+                file << "&";
             }
         }
         file << "," << course->getStartTime() 
              << "," << course->getEndTime() 
-             << "," << course->getDescription() << "\n";
+             << ",\"" << course->getDescription() << "\"\n";
+    }
+}
+
+void LMS::saveEnrollmentsToCSV(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening " << filename << " for writing." << std::endl;
+        return;
+    }
+
+    file << "NetID,CourseCode\n";
+    for (const auto& student : students) {
+        for (const std::string& courseCode : student->getEnrolledCourses()) {
+            file << student->getID() << "," << courseCode << "\n";
+        }
     }
 }
 
 
 // Add new entities to the system
-void LMS::addStudent(const std::string& fname, const std::string& lName, int sYear, const std::string& netID) {
+void LMS::addStudent(std::string fname, std::string lName, int sYear, std::string netID) {
     // Check if a student with the same NetID already exists
     for (Student* existingStudent : students) {
         if (existingStudent->getID() == netID) {
@@ -334,15 +444,16 @@ void LMS::addStudent(const std::string& fname, const std::string& lName, int sYe
     }
 
     // If no existing student found with the same NetID, add the new student
-    Student* newStudent = new Student(fname, lName, sYear, netID);
+    Student* newStudent = new Student(std::move(fname), std::move(lName), sYear, std::move(netID));
     students.push_back(newStudent);
-    std::cout << "Added Student: " << fname << " with ID: " << newStudent->getID() << std::endl;
-    saveStudentsToCSV("students.csv"); // Save updated students to CSV
+    for (LMSObserver* observer : observers) observer->onStudentAdded(*newStudent);
+    std::cout << "Added Student: " << newStudent->getFirstName() << " with ID: " << newStudent->getID() << std::endl;
+    saveStudentsToCSV(studentsFile); // Save updated students to CSV
     std::cout << "Total students: " << students.size() << std::endl;
 }
 
 
-void LMS::addInstructor(const std::string& fname, const std::string& lName, const std::string& empid) {
+void LMS::addInstructor(std::string fname, std::string lName, std::string empid) {
     // Check if an instructor with the same EmpID already exists
     for (Instructor* existingInstructor : instructors) {
         if (existingInstructor->getEmployeeID() == empid) {
@@ -353,17 +464,18 @@ void LMS::addInstructor(const std::string& fname, const std::string& lName, cons
     }
 
     // If no existing instructor found with the same EmpID, add the new instructor
-    Instructor* newInstructor = new Instructor(fname, lName, empid);
+    Instructor* newInstructor = new Instructor(std::move(fname), std::move(lName), std::move(empid));
     instructors.push_back(newInstructor);
-    std::cout << "Added Instructor: " << fname << std::endl;
-    saveInstructorsToCSV("instructors.csv"); // Save updated instructors to CSV
+    for (LMSObserver* observer : observers) observer->onInstructorAdded(*newInstructor);
+    std::cout << "Added Instructor: " << newInstructor->getFirstName() << std::endl;
+    saveInstructorsToCSV(instructorsFile); // Save updated instructors to CSV
 }
 
 
 
-void LMS::addCourse(const std::string& code, const std::string& name, Instructor& instructor,
-                    const std::vector<std::string>& daysOfWeek, const std::string& startTime,
-                    const std::string& endTime, const std::string& description) {
+void LMS::addCourse(std::string code, std::string name, Instructor& instructor,
+                    std::vector<std::string> daysOfWeek, std::string startTime,
+                    std::string endTime, std::string description) {
     // Check if a course with the same CourseCode already exists
     for (Course* existingCourse : courses) {
         if (existingCourse->getCourseCode() == code) {
@@ -374,16 +486,18 @@ void LMS::addCourse(const std::string& code, const std::string& name, Instructor
     }
 
     // If no existing course found with the same CourseCode, add the new course
-    Course* newCourse = new Course(code, name, instructor, daysOfWeek, startTime, endTime, description);
+    Course* newCourse = new Course(std::move(code), std::move(name), instructor, std::move(daysOfWeek),
+                                   std::move(startTime), std::move(endTime), std::move(description));
     courses.push_back(newCourse);
-    std::cout << "Added Course: " << name << std::endl;
-    saveCoursesToCSV("courses.csv"); // Save updated courses to CSV
+    for (LMSObserver* observer : observers) observer->onCourseAdded(*newCourse);
+    std::cout << "Added Course: " << newCourse->getCourseName() << std::endl;
+    saveCoursesToCSV(coursesFile); // Save updated courses to CSV
 }
 
 
 
 // Helper functions to find entities by their IDs
-Student* LMS::findStudentByID(const std::string& id) {
+Student* LMS::findStudentByID(std::string_view id) {
     for (Student* student : students) {
        // std::cout << "Checking student with ID: " << student->getID() << std::endl;
         if (student->getID() == id) {
@@ -393,7 +507,7 @@ Student* LMS::findStudentByID(const std::string& id) {
     return nullptr;
 }
 
-Instructor* LMS::findInstructorByID(const std::string& id) {
+Instructor* LMS::findInstructorByID(std::string_view id) {
     for (Instructor* instructor : instructors) {
         if (instructor->getEmployeeID() == id) {
             return instructor;
@@ -403,7 +517,7 @@ Instructor* LMS::findInstructorByID(const std::string& id) {
 }
 
 
-Course* LMS::findCourseByID(const std::string& id) {
+Course* LMS::findCourseByID(std::string_view id) {
         for (Course* course : courses) {
             if (course->getCourseCode() == id) {
                 return course;
@@ -414,37 +528,54 @@ Course* LMS::findCourseByID(const std::string& id) {
 
 
 // Remove entities from the system
-bool LMS::removeStudentByNetID(const std::string& netID) {
-    auto it = std::remove_if(students.begin(), students.end(),
-                             [&netID](Student* student) { return student->getID() == netID; });
+bool LMS::removeStudentByNetID(std::string_view netID) {
+    // Use find_if, not remove_if: the tail left by remove_if is unspecified, so deleting *it could free a kept entry
+    auto it = std::find_if(students.begin(), students.end(),
+                           [&netID](Student* student) { return student->getID() == netID; });
     if (it != students.end()) {
+        // Copy the ID first: netID may refer to the student's own member, which the delete frees
+        std::string removedID = (*it)->getID();
         delete *it;  // Free the memory
-        students.erase(it, students.end());
-        saveStudentsToCSV("students.csv");
+        students.erase(it);
+        saveStudentsToCSV(studentsFile);
+        saveEnrollmentsToCSV(enrollmentsFile);
+        for (LMSObserver* observer : observers) observer->onStudentRemoved(removedID);
         return true;
     }
     return false;
 }
 
-bool LMS::removeInstructorByEmpID(const std::string& empID) {
-    auto it = std::remove_if(instructors.begin(), instructors.end(),
-                             [&empID](Instructor* instructor) { return instructor->getEmployeeID() == empID; });
+bool LMS::removeInstructorByEmpID(std::string_view empID) {
+    auto it = std::find_if(instructors.begin(), instructors.end(),
+                           [&empID](Instructor* instructor) { return instructor->getEmployeeID() == empID; });
     if (it != instructors.end()) {
+        // A course keeps only its instructor's EmployeeID and would be skipped when courses.csv is loaded again
+        for (const Course* course : courses) {
+            if (course->getCourseInstructor() == empID) {
+                std::cout << "Instructor " << empID << " still teaches " << course->getCourseCode()
+                          << " and cannot be removed." << std::endl;
+                return false;
+            }
+        }
+        std::string removedID = (*it)->getEmployeeID();
         delete *it;  // Free the memory
-        instructors.erase(it, instructors.end());
-        saveInstructorsToCSV("instructors.csv");
+        instructors.erase(it);
+        saveInstructorsToCSV(instructorsFile);
+        for (LMSObserver* observer : observers) observer->onInstructorRemoved(removedID);
         return true;
     }
     return false;
 }
 
-bool LMS::removeCourseByCode(const std::string& code) {
-    auto it = std::remove_if(courses.begin(), courses.end(),
-                             [&code](Course* course) { return course->getCourseCode() == code; });
+bool LMS::removeCourseByCode(std::string_view code) {
+    auto it = std::find_if(courses.begin(), courses.end(),
+                           [&code](Course* course) { return course->getCourseCode() == code; });
     if (it != courses.end()) {
+        std::string removedCode = (*it)->getCourseCode();
         delete *it;  // Free the memory
-        courses.erase(it, courses.end());
-        saveCoursesToCSV("courses.csv");
+        courses.erase(it);
+        saveCoursesToCSV(coursesFile);
+        for (LMSObserver* observer : observers) observer->onCourseRemoved(removedCode);
         return true;
     }
     return false;
@@ -467,16 +598,25 @@ bool LMS::clashCheck(const Student& student, const Course& newCourse) const {
 void LMS::enrollStudent(Student& student, Course& course) {
         if (!student.isEnrolledIn(course.getCourseCode())) {
             student.enrollIn(course.getCourseCode());
+            std::cout << "Enrollment in course Success" << std::endl;
+            saveEnrollmentsToCSV(enrollmentsFile);
+            for (LMSObserver* observer : observers) observer->onStudentEnrolled(student, course);
         } else {
             std::cout << "Student already enrolled in this course!" << std::endl;
         }
     }
 
 // Drop a student from a course
-void LMS::dropStudent(const std::string& studentID, const std::string& courseCode) {
+void LMS::dropStudent(std::string_view studentID, std::string_view courseCode) {
         Student* student = findStudentByID(studentID);
         if (student && student->dropCourse(courseCode)) {
             std::cout << "Dropped student from course: " << courseCode << std::endl;
+            saveEnrollmentsToCSV(enrollmentsFile);
+            if (!observers.empty()) {
+                // Observers take the code as a string; only pay for the copy when someone is listening
+                std::string droppedCode(courseCode);
+                for (LMSObserver* observer : observers) observer->onStudentDropped(*student, droppedCode);
+            }
         } else {
             std::cout << "Failed to drop student from course: " << courseCode << std::endl;
         }
@@ -484,7 +624,7 @@ void LMS::dropStudent(const std::string& studentID, const std::string& courseCod
 
 
 // Print the schedule for a student
-void LMS::printSchedule(const std::string& studentID) {
+void LMS::printSchedule(std::string_view studentID) {
     Student* student = findStudentByID(studentID);
     if (student) {
         std::cout << "Schedule for: " << student->getFirstName() << " " << student->getLastName() << std::endl;
@@ -513,4 +653,20 @@ const std::vector<Instructor*>& LMS::getInstructors() const {
 
 const std::vector<Course*>& LMS::getCourses() const {
         return courses;
-    }
\ No newline at end of file
+    }
+
+const std::string& LMS::getDataDirectory() const {
+        return dataDirectory;
+    }
+
+
+// Register or unregister an observer notified after each successful mutation
+void LMS::addObserver(LMSObserver* observer) {
+    if (observer && std::find(observers.begin(), observers.end(), observer) == observers.end()) {
+        observers.push_back(observer);
+    }
+}
+
+void LMS::removeObserver(LMSObserver* observer) {
+    observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+}
@@ -6,6 +6,7 @@
 // Header files for standard library and STL containers
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
 #include <cstdlib>
@@ -36,17 +37,18 @@ private:
     std::string firstName;
     std::string lastName;
     std::string employeeID;
+    std::string fullName;
 
 public:
-    // Constructor to initialize an Instructor object
-    Instructor(const std::string& fName, const std::string& lName, const std::string& empID);
+    // Constructor to initialize an Instructor object; arguments are moved into the members
+    Instructor(std::string fName, std::string lName, std::string empID);
 
 
     // Getter methods for Instructor attributes
-    std::string getFirstName() const;
-    std::string getLastName() const;
-    std::string getFullName() const;
-    std::string getEmployeeID() const;
+    const std::string& getFirstName() const;
+    const std::string& getLastName() const;
+    const std::string& getFullName() const;
+    const std::string& getEmployeeID() const;
 
 
 };
@@ -54,10 +56,10 @@ public:
 // Represents a Course with various attributes like course code, name, instructor, schedule details, etc.
 class Course {
 public:
-    // Constructor to initialize a Course object
-    Course(const std::string& code, const std::string& name, const Instructor& instructor,
-           const std::vector<std::string>& daysOfWeek, const std::string& startTime,
-           const std::string& endTime, const std::string& description = "");
+    // Constructor to initialize a Course object; arguments are moved into the members
+    Course(std::string code, std::string name, const Instructor& instructor,
+           std::vector<std::string> daysOfWeek, std::string startTime,
+           std::string endTime, std::string description = "");
 
     // Destructor
     ~Course();
@@ -90,8 +92,8 @@ private:
 // Represents a Student with various attributes and functionality to manage courses
 class Student : public Data {
 public:
-    // Constructor to initialize a Student object
-    Student(const std::string& fname, const std::string& lName, int sYear, const std::string& netID);
+    // Constructor to initialize a Student object; arguments are moved into the members
+    Student(std::string fname, std::string lName, int sYear, std::string netID);
 
     // Display student information in a structured format
     void printStudentInfo() const;
@@ -100,10 +102,10 @@ public:
     const std::string& getID() const override;
 
     // Check if the student is enrolled in a specific course
-    bool isEnrolledIn(const std::string& courseCode) const;
+    bool isEnrolledIn(std::string_view courseCode) const;
 
     // Enroll a student in a specific course
-    void enrollIn(const std::string& courseCode);
+    void enrollIn(std::string courseCode);
 
     // Getter methods for Student attributes
     const std::vector<std::string>& getEnrolledCourses() const;
@@ -112,27 +114,54 @@ public:
     int getYear() const;
 
     // Drop a student from a specific course
-    bool dropCourse(const std::string& courseCode);
+    bool dropCourse(std::string_view courseCode);
 
 private:
     int studentYear;
     std::vector<std::string> enrolledCourseCodes;
 };
 
+// Interface for components that follow LMS mutations (e.g. analytics views)
+// Default implementations ignore the event so observers only override what they need
+class LMSObserver {
+public:
+    virtual ~LMSObserver() = default;
+
+    virtual void onStudentAdded(const Student&) {}
+    virtual void onStudentRemoved(const std::string&) {}
+    virtual void onInstructorAdded(const Instructor&) {}
+    virtual void onInstructorRemoved(const std::string&) {}
+    virtual void onCourseAdded(const Course&) {}
+    virtual void onCourseRemoved(const std::string&) {}
+    virtual void onStudentEnrolled(const Student&, const Course&) {}
+    virtual void onStudentDropped(const Student&, const std::string&) {}
+};
+
 // Represents the Learning Management System (LMS) with functionality to manage students, instructors, and courses
 class LMS {
 private:
     std::vector<Student*> students;
     std::vector<Instructor*> instructors;
     std::vector<Course*> courses;
+    std::vector<LMSObserver*> observers;
+
+    // CSV files this LMS loads from and saves to, inside its data directory
+    std::string dataDirectory;
+    std::string studentsFile;
+    std::string instructorsFile;
+    std::string coursesFile;
+    std::string enrollmentsFile;
 
     // Helper function to find a course by its code
-    Course* findCourseByCode(const std::string& courseCode) const;
+    Course* findCourseByCode(std::string_view courseCode) const;
 
 public:
-    // Constructor to initialize the LMS object and load data from CSV files
+    // Constructor to initialize the LMS object and load data from CSV files in the working directory
     LMS();
 
+    // Constructor to load from and save to the CSV files in a given data directory (e.g. one per term or campus)
+    explicit LMS(const std::string& dataDirectory);
+
     // Destructor to deallocate memory used by dynamically allocated objects
     ~LMS();
 
@@ -140,44 +169,53 @@ public:
     void loadStudentsFromCSV(const std::string& filename);
     void loadInstructorsFromCSV(const std::string& filename);
     void loadCoursesFromCSV(const std::string& filename);
+    void loadEnrollmentsFromCSV(const std::string& filename);
 
     // Save data to CSV files
     void saveStudentsToCSV(const std::string& filename);
     void saveInstructorsToCSV(const std::string& filename);
     void saveCoursesToCSV(const std::string& filename);
+    void saveEnrollmentsToCSV(const std::string& filename);
 
   
-    // Add new entities to the system
-    void addStudent(const std::string& fname, const std::string& lName, int sYear, const std::string& netID);
-    void addInstructor(const std::string& fname, const std::string& lName, const std::string& empid);
-    void addCourse(const std::string& code, const std::string& name, Instructor& instructor,
-                   const std::vector<std::string>& daysOfWeek, const std::string& startTime,
-                   const std::string& endTime, const std::string& description);
+    // Add new entities to the system; arguments are moved into the new object
+    void addStudent(std::string fname, std::string lName, int sYear, std::string netID);
+    void addInstructor(std::string fname, std::string lName, std::string empid);
+    void addCourse(std::string code, std::string name, Instructor& instructor,
+                   std::vector<std::string> daysOfWeek, std::string startTime,
+                   std::string endTime, std::string description);
 
     // Helper functions to find entities by their IDs
-    Student* findStudentByID(const std::string& id);
-    Instructor* findInstructorByID(const std::string& id);
-    Course* findCourseByID(const std::string& id);
+    Student* findStudentByID(std::string_view id);
+    Instructor* findInstructorByID(std::string_view id);
+    Course* findCourseByID(std::string_view id);
 
     // Remove entities from the system
-    bool removeStudentByNetID(const std::string& netID);
-    bool removeInstructorByEmpID(const std::string& empID);
-    bool removeCourseByCode(const std::string& code);
+    bool removeStudentByNetID(std::string_view netID);
+    bool removeInstructorByEmpID(std::string_view empID);
+    bool removeCourseByCode(std::string_view code);
 
     // Check for scheduling clashes for a student
     bool clashCheck(const Student& student, const Course& newCourse) const;
 
     // Enroll or drop a student from a course
     void enrollStudent(Student& student, Course& course);
-    void dropStudent(const std::string& studentID, const std::string& courseCode);
+    void dropStudent(std::string_view studentID, std::string_view courseCode);
 
     // Print the schedule for a student
-    void printSchedule(const std::string& studentID);
+    void printSchedule(std::string_view studentID);
 
     // Getter methods to retrieve lists of students, instructors, and courses
     const std::vector<Student*>& getStudents() const;
     const std::vector<Instructor*>& getInstructors() const;
     const std::vector<Course*>& getCourses() const;
+
+    // Directory holding this LMS's CSV files; empty for the working directory
+    const std::string& getDataDirectory() const;
+
+    // Register or unregister an observer notified after each successful mutation
+    void addObserver(LMSObserver* observer);
+    void removeObserver(LMSObserver* observer);
 };
 
 #endif // LMS_H
@@ -0,0 +1,460 @@
+#include "LMSVerify.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <new>
+
+
+bool LMSSnapshot::StudentRow::operator==(const StudentRow& other) const {
+    return firstName == other.firstName && lastName == other.lastName && netID == other.netID &&
+           year == other.year && enrolledCourses == other.enrolledCourses;
+}
+
+bool LMSSnapshot::InstructorRow::operator==(const InstructorRow& other) const {
+    return firstName == other.firstName && lastName == other.lastName && employeeID == other.employeeID;
+}
+
+bool LMSSnapshot::CourseRow::operator==(const CourseRow& other) const {
+    return code == other.code && name == other.name && instructor == other.instructor &&
+           startTime == other.startTime && endTime == other.endTime && description == other.description &&
+           daysOfWeek == other.daysOfWeek;
+}
+
+namespace {
+
+// Compare two tables row by row, reporting the first mismatching row by its key
+template <class Row, class Key>
+std::string compareRows(const char* table, const std::vector<Row>& expected, const std::vector<Row>& actual,
+                        Key key) {
+    if (expected.size() != actual.size()) {
+        return std::string(table) + " count differs: expected " + std::to_string(expected.size()) +
+               ", got " + std::to_string(actual.size());
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (!(expected[i] == actual[i])) {
+            return std::string(table) + " row " + std::to_string(i) + " differs: expected " + key(expected[i]) +
+                   ", got " + key(actual[i]);
+        }
+    }
+    return "";
+}
+
+} // namespace
+
+// Describe the first difference between two snapshots; empty when they are identical
+std::string describeDifference(const LMSSnapshot& expected, const LMSSnapshot& actual) {
+    std::string difference = compareRows("students", expected.students, actual.students,
+                                         [](const LMSSnapshot::StudentRow& row) {
+                                             std::string text = row.netID + " [";
+                                             for (const std::string& code : row.enrolledCourses) text += " " + code;
+                                             return text + " ]";
+                                         });
+    if (difference.empty()) {
+        difference = compareRows("instructors", expected.instructors, actual.instructors,
+                                 [](const LMSSnapshot::InstructorRow& row) { return row.employeeID; });
+    }
+    if (difference.empty()) {
+        difference = compareRows("courses", expected.courses, actual.courses,
+                                 [](const LMSSnapshot::CourseRow& row) { return row.code; });
+    }
+    return difference;
+}
+
+
+ScratchDirectory::ScratchDirectory(const std::string& prefix) {
+    static std::random_device device;
+    static std::atomic<uint64_t> counter(0);
+    const std::filesystem::path base = std::filesystem::temp_directory_path();
+
+    // create_directory reports false when the name is taken, so retry until this process owns a fresh one
+    std::filesystem::path candidate;
+    do {
+        char suffix[40];
+        std::snprintf(suffix, sizeof(suffix), "_%08x%08x_%llu", device(), device(),
+                      static_cast<unsigned long long>(counter.fetch_add(1)));
+        candidate = base / (prefix + suffix);
+    } while (!std::filesystem::create_directory(candidate));
+    directory = candidate.string();
+}
+
+ScratchDirectory::~ScratchDirectory() {
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+}
+
+const std::string& ScratchDirectory::path() const {
+    return directory;
+}
+
+void writeDataFiles(const std::string& directory, const std::vector<std::string>& bodies) {
+    static const char* const names[] = {"students.csv", "instructors.csv", "courses.csv", "enrollments.csv"};
+    for (size_t i = 0; i < 4 && i < bodies.size(); ++i) {
+        if (!bodies[i].empty()) {
+            std::ofstream file(std::filesystem::path(directory) / names[i], std::ios::binary | std::ios::trunc);
+            file.write(bodies[i].data(), static_cast<std::streamsize>(bodies[i].size()));
+        }
+    }
+}
+
+
+// Class compared against the reference LMS by the drivers below. Define LMS_CANDIDATE (and
+// LMS_CANDIDATE_HEADER, a quoted file name, to include its declaration) to check another implementation.
+#ifdef LMS_CANDIDATE_HEADER
+#include LMS_CANDIDATE_HEADER
+#endif
+#ifndef LMS_CANDIDATE
+#define LMS_CANDIDATE LMS
+#endif
+
+
+#ifdef LMS_FUZZ_CSV
+// libFuzzer entry point for the CSV loaders. The first byte selects which data file the rest of the input
+// replaces; the other files hold a small valid data set so courses and enrollments have something to refer to.
+// The reference LMS and LMS_CANDIDATE load the same files and must end up identical.
+// Build: clang++ -std=c++17 -g -O1 -DLMS_FUZZ_CSV -fsanitize=fuzzer,address,undefined LMS.cpp LMSVerify.cpp
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+
+    std::vector<std::string> bodies = {
+        "FirstName,LastName,Year,NetID\nJohn,Doe,2023,JD933\nJane,Smith,2022,JS743\n",
+        "FirstName,LastName,EmployeeID,NetID\nProf,Jason,PM1234,PM1234\n",
+        "CourseCode,CourseName,InstructorEmpID,DaysOfWeek,StartTime,EndTime,Description\n"
+        "PHY201,Advanced Physics,PM1234,Tue&Thu,09:00,10:30,\"Advanced physics topics.\"\n",
+        "NetID,CourseCode\nJD933,PHY201\n"
+    };
+    bodies[data[0] % bodies.size()].assign(reinterpret_cast<const char*>(data + 1), size - 1);
+
+    std::string failure = runLoaderDifferential<LMS_CANDIDATE>(bodies);
+    if (!failure.empty()) {
+        std::cerr << "Loader mismatch " << failure << std::endl;
+        std::abort();
+    }
+    return 0;
+}
+#endif // LMS_FUZZ_CSV
+
+
+#ifdef LMS_DIFFERENTIAL_MAIN
+// Standalone differential run of the reference LMS against LMS_CANDIDATE (by default itself).
+// Build: g++ -std=c++17 -g -DLMS_DIFFERENTIAL_MAIN -fsanitize=address,undefined LMS.cpp LMSVerify.cpp
+int main(int argc, char* argv[]) {
+    unsigned seeds = argc > 1 ? static_cast<unsigned>(std::stoul(argv[1])) : 100;
+    size_t steps = argc > 2 ? static_cast<size_t>(std::stoul(argv[2])) : 500;
+
+    for (unsigned seed = 0; seed < seeds; ++seed) {
+        std::string failure = runDifferential<LMS_CANDIDATE>(seed, steps);
+        if (!failure.empty()) {
+            std::cerr << "Differential mismatch at " << failure << std::endl;
+            return 1;
+        }
+    }
+    std::cerr << "Differential run passed: " << seeds << " seeds x " << steps << " steps" << std::endl;
+    return 0;
+}
+#endif // LMS_DIFFERENTIAL_MAIN
+
+
+#ifdef LMS_ALLOC_COUNT_MAIN
+// Counts heap allocations made while loading and querying a generated data set, so the cost of the
+// loaders and lookups can be compared between revisions. IDs are longer than the small-string buffer
+// so that any temporary std::string built for a lookup key shows up as an allocation.
+// Build: g++ -std=c++17 -O2 -DLMS_ALLOC_COUNT_MAIN LMS.cpp LMSVerify.cpp -o lms_allocs && ./lms_allocs 20000
+static size_t allocationCount = 0;
+
+void* operator new(size_t size) {
+    ++allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+int main(int argc, char* argv[]) {
+    const size_t studentCount = argc > 1 ? static_cast<size_t>(std::stoul(argv[1])) : 20000;
+    const size_t instructorCount = studentCount / 10 + 1;
+    const ScratchDirectory scratch("lms_alloc_count");
+    const std::filesystem::path directory = scratch.path();
+
+    {
+        std::ofstream students(directory / "students.csv");
+        students << "FirstName,LastName,Year,NetID\n";
+        for (size_t i = 0; i < studentCount; ++i) {
+            students << "Firstname" << i << ",Lastname" << i << "," << 2020 + i % 5 << ",STUDENT-NETID-" << i << "\n";
+        }
+        std::ofstream instructors(directory / "instructors.csv");
+        instructors << "FirstName,LastName,EmployeeID,NetID\n";
+        for (size_t i = 0; i < instructorCount; ++i) {
+            instructors << "Professor" << i << ",Instructor" << i << ",EMPLOYEE-ID-" << i << ",EMPLOYEE-ID-" << i << "\n";
+        }
+        std::ofstream courses(directory / "courses.csv");
+        courses << "CourseCode,CourseName,InstructorEmpID,DaysOfWeek,StartTime,EndTime,Description\n";
+        for (size_t i = 0; i < instructorCount; ++i) {
+            courses << "COURSE-CODE-" << i << ",Course name " << i << ",EMPLOYEE-ID-" << i
+                    << ",Mon&Wed,09:00,10:30,\"Description of course " << i << ".\"\n";
+        }
+    }
+
+    size_t before = allocationCount;
+    LMS lms(directory.string());
+    const size_t loadAllocations = allocationCount - before;
+
+    const int rounds = 1000;
+    before = allocationCount;
+    for (int i = 0; i < rounds; ++i) {
+        lms.findStudentByID("STUDENT-NETID-0");
+        lms.findInstructorByID("EMPLOYEE-ID-0");
+        lms.findCourseByID("COURSE-CODE-0");
+        lms.removeCourseByCode("COURSE-CODE-MISSING");
+    }
+    const size_t lookupAllocations = allocationCount - before;
+
+    before = allocationCount;
+    size_t nameLength = 0;
+    for (const Instructor* instructor : lms.getInstructors()) {
+        nameLength += instructor->getFullName().size() + instructor->getEmployeeID().size();
+    }
+    const size_t getterAllocations = allocationCount - before;
+
+    std::printf("load %zu students, %zu instructors, %zu courses: %zu allocations\n",
+                lms.getStudents().size(), lms.getInstructors().size(), lms.getCourses().size(), loadAllocations);
+    std::printf("%d x (3 find* + 1 failed remove) with literal keys: %zu allocations\n", rounds, lookupAllocations);
+    std::printf("getFullName + getEmployeeID on every instructor: %zu allocations (%zu chars)\n",
+                getterAllocations, nameLength);
+    return 0;
+}
+#endif // LMS_ALLOC_COUNT_MAIN
+
+
+#ifdef LMS_CONCURRENCY_MAIN
+// Concurrent driver for the lock-free parts. Several threads submit enroll/drop requests to an
+// EnrollmentQueue while this thread, as the LMS owner, drains it. Every future and callback must
+// complete, and since each student belongs to one submitter, their requests must take effect in order.
+// Meanwhile reader threads follow a ChangeFeed, which the LMS thread also fills with students whose
+// IDs are too long for a slot, and check that every event they get is whole and in sequence. A final
+// burst publishes straight into a tiny ring so that slots are overwritten while they are being read.
+// Build: g++ -std=c++17 -g -O1 -DLMS_CONCURRENCY_MAIN -fsanitize=thread -pthread LMS.cpp EnrollmentQueue.cpp ChangeFeed.cpp LMSVerify.cpp
+#include "ChangeFeed.h"
+#include "EnrollmentQueue.h"
+
+#include <mutex>
+#include <set>
+#include <thread>
+
+// Counters and first failure shared by the feed readers
+struct FeedReaderTally {
+    std::mutex mutex;
+    std::string failure;
+    std::atomic<size_t> events{0};
+    std::atomic<size_t> spilled{0};
+};
+
+// Follow feed until stop is set and the reader has caught up, checking each event on its own.
+// A lapped reader simply skips ahead, since only the ring itself is under test.
+static void followFeed(const ChangeFeed& feed, const std::atomic<bool>& stop, FeedReaderTally& tally) {
+    const std::string longID(150, 'L');
+    auto fail = [&tally](const std::string& what, uint64_t sequence) {
+        std::lock_guard<std::mutex> lock(tally.mutex);
+        if (tally.failure.empty()) tally.failure = what + " at sequence " + std::to_string(sequence);
+    };
+
+    ChangeSubscription subscription(feed, feed.epoch(), feed.oldestSequence());
+    std::vector<ChangeEvent> batch;
+    uint64_t last = 0;
+    while (!stop.load(std::memory_order_acquire) || subscription.nextSequence() <= feed.latestSequence()) {
+        batch.clear();
+        const ChangeFeed::ReadStatus status = subscription.poll(batch, 16);
+        if (status == ChangeFeed::ReadStatus::Lapped) {
+            subscription.resumeFrom(feed.oldestSequence());
+            last = 0;
+            continue;
+        }
+        if (status == ChangeFeed::ReadStatus::Reset) {
+            fail("Reset", subscription.nextSequence());
+            return;
+        }
+        for (const ChangeEvent& event : batch) {
+            if (last != 0 && event.sequence != last + 1) fail("gap in sequences", event.sequence);
+            last = event.sequence;
+            const bool studentEvent = event.type == ChangeType::StudentAdded || event.type == ChangeType::StudentRemoved ||
+                                      event.type == ChangeType::StudentEnrolled || event.type == ChangeType::StudentDropped;
+            if (studentEvent && (event.key.empty() || (event.key[0] != 'T' && event.key != longID))) {
+                fail("damaged student ID", event.sequence);
+            }
+            if (event.type == ChangeType::StudentAdded &&
+                (event.firstName != "First" || event.lastName != "Last" || event.year < 2021 || event.year > 2024)) {
+                fail("StudentAdded without its fields", event.sequence);
+            }
+            if ((event.type == ChangeType::StudentEnrolled || event.type == ChangeType::StudentDropped) &&
+                (event.courseCode.size() != 2 || event.courseCode[0] != 'C')) {
+                fail("damaged course code", event.sequence);
+            }
+            tally.spilled.fetch_add(event.key == longID, std::memory_order_relaxed);
+        }
+        tally.events.fetch_add(batch.size(), std::memory_order_relaxed);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const size_t submitters = argc > 1 ? static_cast<size_t>(std::stoul(argv[1])) : 4;
+    const size_t requestsPerSubmitter = argc > 2 ? static_cast<size_t>(std::stoul(argv[2])) : 2000;
+    const size_t studentsPerSubmitter = 8;
+    const size_t courseCount = 6;
+    const size_t readerCount = 3;
+    const ScratchDirectory scratch("lms_concurrency");
+    LMS lms(scratch.path());
+    ChangeFeed feed(lms, 64);
+
+    // The LMS reports every mutation on std::cout; silence it so the summary on std::cerr stays readable
+    std::cout.setstate(std::ios::failbit);
+    lms.addInstructor("Prof", "Jason", "PM1234");
+    for (size_t c = 0; c < courseCount; ++c) {
+        lms.addCourse("C" + std::to_string(c), "Course " + std::to_string(c), *lms.findInstructorByID("PM1234"),
+                      {"Mon", "Wed"}, "09:00", "10:30", "Generated.");
+    }
+    auto studentID = [](size_t submitter, size_t student) {
+        return "T" + std::to_string(submitter) + "S" + std::to_string(student);
+    };
+    for (size_t t = 0; t < submitters; ++t) {
+        for (size_t s = 0; s < studentsPerSubmitter; ++s) {
+            lms.addStudent("First", "Last", 2021 + static_cast<int>(s % 4), studentID(t, s));
+        }
+    }
+
+    FeedReaderTally tally;
+    std::atomic<bool> stopReaders(false);
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < readerCount; ++r) {
+        readers.emplace_back(followFeed, std::cref(feed), std::cref(stopReaders), std::ref(tally));
+    }
+
+    EnrollmentQueue queue(lms, 2);
+    std::atomic<size_t> callbacks(0);
+    std::atomic<size_t> finishedSubmitters(0);
+    std::vector<std::vector<std::future<EnrollmentResult>>> futures(submitters);
+    std::vector<std::set<std::string>> expected(submitters * studentsPerSubmitter);
+
+    // Each submitter only touches its own futures and expected sets until it is joined
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < submitters; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(static_cast<unsigned>(t));
+            auto countCallback = [&callbacks](const EnrollmentResult&) { callbacks.fetch_add(1); };
+            for (size_t i = 0; i < requestsPerSubmitter; ++i) {
+                const size_t s = rng() % studentsPerSubmitter;
+                const std::string code = "C" + std::to_string(rng() % courseCount);
+                std::set<std::string>& enrolled = expected[t * studentsPerSubmitter + s];
+                if (rng() % 3 == 0) {
+                    enrolled.erase(code);
+                    futures[t].push_back(queue.submitDrop(studentID(t, s), code, countCallback));
+                } else {
+                    enrolled.insert(code);
+                    futures[t].push_back(queue.submitEnroll(studentID(t, s), code, countCallback));
+                }
+            }
+            finishedSubmitters.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    // depth() counts a request from before it is pushed, so once every submitter is done it reaching 0 means all were applied
+    // Between batches, add and remove a student whose ID only fits in the feed's spill table
+    const std::string longID(150, 'L');
+    while (finishedSubmitters.load(std::memory_order_acquire) < submitters || queue.depth() > 0) {
+        lms.addStudent("First", "Last", 2022, longID);
+        lms.removeStudentByNetID(longID);
+        if (queue.drain(64) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    stopReaders.store(true, std::memory_order_release);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    std::cout.clear();
+
+    std::string failure;
+    const size_t total = submitters * requestsPerSubmitter;
+    for (auto& submitterFutures : futures) {
+        for (auto& future : submitterFutures) {
+            if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                failure = "a future was left unresolved";
+            } else {
+                future.get();
+            }
+        }
+    }
+    const EnrollmentQueueMetrics metrics = queue.getMetrics();
+    if (callbacks.load() != total || metrics.submitted != total || metrics.completed != total || metrics.depth != 0) {
+        failure = "counters disagree: " + std::to_string(callbacks.load()) + " callbacks, " +
+                  std::to_string(metrics.completed) + " of " + std::to_string(total) + " completed";
+    }
+    for (size_t t = 0; t < submitters && failure.empty(); ++t) {
+        for (size_t s = 0; s < studentsPerSubmitter && failure.empty(); ++s) {
+            const std::vector<std::string>& courses = lms.findStudentByID(studentID(t, s))->getEnrolledCourses();
+            if (std::set<std::string>(courses.begin(), courses.end()) != expected[t * studentsPerSubmitter + s]) {
+                failure = "requests of " + studentID(t, s) + " were applied out of order";
+            }
+        }
+    }
+
+    // The resync snapshot, taken here on the LMS thread, must hold exactly the expected enrollments
+    const ChangeSnapshot snapshot = feed.snapshot();
+    size_t expectedEnrollments = 0, snapshotEnrollments = 0;
+    for (const std::set<std::string>& enrolled : expected) expectedEnrollments += enrolled.size();
+    for (const ChangeEvent& event : snapshot.events) {
+        snapshotEnrollments += event.type == ChangeType::StudentEnrolled;
+    }
+    if (failure.empty() && (snapshot.sequence != feed.latestSequence() || snapshotEnrollments != expectedEnrollments)) {
+        failure = "snapshot holds " + std::to_string(snapshotEnrollments) + " enrollments, expected " +
+                  std::to_string(expectedEnrollments);
+    }
+
+    // Burst: publish through the observer interface, without the CSV saves of real mutations in between,
+    // so a four-slot ring wraps under the readers as fast as this thread can go
+    const size_t burstEvents = 50 * total;
+    {
+        ChangeFeed burstFeed(lms, 4);
+        stopReaders.store(false);
+        readers.clear();
+        for (size_t r = 0; r < readerCount; ++r) {
+            readers.emplace_back(followFeed, std::cref(burstFeed), std::cref(stopReaders), std::ref(tally));
+        }
+        const Student shortStudent("First", "Last", 2021, studentID(0, 0));
+        const Student longStudent("First", "Last", 2024, longID);
+        const Course& course = *lms.findCourseByID("C0");
+        // Three event kinds against four slots, so each slot is overwritten by a different kind than it held
+        // and a read torn between the two shows up as an event missing its fields
+        for (size_t i = 0; i < burstEvents; ++i) {
+            const Student& student = i % 4 == 0 ? longStudent : shortStudent;
+            switch (i % 3) {
+                case 0: burstFeed.onStudentAdded(student); break;
+                case 1: burstFeed.onStudentEnrolled(student, course); break;
+                default: burstFeed.onStudentDropped(student, course.getCourseCode()); break;
+            }
+        }
+        stopReaders.store(true, std::memory_order_release);
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+    }
+    if (failure.empty() && !tally.failure.empty()) {
+        failure = "feed reader saw " + tally.failure;
+    }
+
+    if (!failure.empty()) {
+        std::cerr << "Concurrency check failed: " << failure << std::endl;
+        return 1;
+    }
+    std::cerr << "Concurrency check passed: " << submitters << " submitters x " << requestsPerSubmitter
+              << " requests in " << metrics.batches << " batches; " << readerCount << " feed readers checked "
+              << tally.events.load() << " events (" << tally.spilled.load() << " spilled) of "
+              << feed.latestSequence() + burstEvents << " published" << std::endl;
+    return 0;
+}
+#endif // LMS_CONCURRENCY_MAIN
@@ -0,0 +1,223 @@
+// LMSVerify.h
+
+#ifndef LMS_VERIFY_H
+#define LMS_VERIFY_H
+
+#include "LMS.h"
+
+#include <memory>
+#include <random>
+
+// Plain copy of everything a caller can observe through the LMS getters, used for comparisons
+struct LMSSnapshot {
+    struct StudentRow {
+        std::string firstName, lastName, netID;
+        int year;
+        std::vector<std::string> enrolledCourses;
+        bool operator==(const StudentRow& other) const;
+    };
+    struct InstructorRow {
+        std::string firstName, lastName, employeeID;
+        bool operator==(const InstructorRow& other) const;
+    };
+    struct CourseRow {
+        std::string code, name, instructor, startTime, endTime, description;
+        std::vector<std::string> daysOfWeek;
+        bool operator==(const CourseRow& other) const;
+    };
+
+    std::vector<StudentRow> students;
+    std::vector<InstructorRow> instructors;
+    std::vector<CourseRow> courses;
+};
+
+// Capture the observable state of any type exposing the LMS getters
+template <class System>
+LMSSnapshot takeSnapshot(const System& system) {
+    LMSSnapshot snapshot;
+    for (const auto* student : system.getStudents()) {
+        snapshot.students.push_back({student->getFirstName(), student->getLastName(), student->getID(),
+                                     student->getYear(), student->getEnrolledCourses()});
+    }
+    for (const auto* instructor : system.getInstructors()) {
+        snapshot.instructors.push_back({instructor->getFirstName(), instructor->getLastName(),
+                                        instructor->getEmployeeID()});
+    }
+    for (const auto* course : system.getCourses()) {
+        snapshot.courses.push_back({course->getCourseCode(), course->getCourseName(), course->getCourseInstructor(),
+                                    course->getStartTime(), course->getEndTime(), course->getDescription(),
+                                    course->getDaysOfWeek()});
+    }
+    return snapshot;
+}
+
+// Describe the first difference between two snapshots; empty when they are identical
+std::string describeDifference(const LMSSnapshot& expected, const LMSSnapshot& actual);
+
+// Empty data directory under the system temp directory, removed again on destruction.
+// The name gets a random suffix so concurrent runs (parallel fuzz workers, several differential
+// processes) never share or delete each other's directories.
+class ScratchDirectory {
+public:
+    explicit ScratchDirectory(const std::string& prefix);
+    ~ScratchDirectory();
+
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    const std::string& path() const;
+
+private:
+    std::string directory;
+};
+
+// Write the data files an LMS loads on construction: bodies are students.csv, instructors.csv,
+// courses.csv and enrollments.csv in that order, and empty or missing bodies leave the file out
+void writeDataFiles(const std::string& directory, const std::vector<std::string>& bodies);
+
+// Replays the same random sequence of operations against the reference LMS and a Candidate
+// with the same public interface, comparing return values and the full snapshot after every step.
+// Each system is constructed on its own scratch data directory, since both save CSV files as they mutate.
+// Some steps reconstruct both systems from the files they saved, which must not change anything observable.
+// Returns an empty string on success, otherwise a description of the first divergence.
+template <class Candidate>
+std::string runDifferential(unsigned seed, size_t steps) {
+    const ScratchDirectory referenceDir("lms_reference");
+    const ScratchDirectory candidateDir("lms_candidate");
+
+    // Owned by unique_ptr so an exception from any operation cannot leak either system
+    std::unique_ptr<LMS> reference(new LMS(referenceDir.path()));
+    std::unique_ptr<Candidate> candidate(new Candidate(candidateDir.path()));
+
+    // Small pools so that operations collide with existing entities often
+    static const char* const names[] = {"Ann", "Ben", "Cal", "Dee"};
+    static const char* const days[] = {"Mon", "Tue", "Wed", "Thu", "Fri"};
+    static const char* const times[] = {"08:00", "09:30", "11:00", "12:30", "14:00", "15:30"};
+
+    std::mt19937 rng(seed);
+    auto pick = [&rng](size_t n) { return static_cast<size_t>(rng() % n); };
+    auto studentID = [&]() { return "S" + std::to_string(pick(12)); };
+    auto instructorID = [&]() { return "I" + std::to_string(pick(5)); };
+    auto courseCode = [&]() { return "C" + std::to_string(pick(8)); };
+
+    std::string failure;
+    for (size_t step = 0; step < steps && failure.empty(); ++step) {
+        const std::string where = "seed " + std::to_string(seed) + " step " + std::to_string(step) + ": ";
+        const size_t op = pick(11);
+
+        // Run one operation against both systems
+        auto both = [&](auto&& action) {
+            action(*reference);
+            action(*candidate);
+        };
+        auto compare = [&](const char* what, bool expected, bool actual) {
+            if (expected != actual) failure = where + what + " returned different results";
+        };
+        auto compareBoth = [&](const char* what, auto&& action) {
+            compare(what, action(*reference), action(*candidate));
+        };
+
+        if (op == 0) {
+            std::string id = studentID();
+            std::string first = names[pick(4)];
+            int year = 2021 + static_cast<int>(pick(4));
+            both([&](auto& system) { system.addStudent(first, "Doe", year, id); });
+        } else if (op == 1) {
+            std::string id = instructorID();
+            std::string first = names[pick(4)];
+            both([&](auto& system) { system.addInstructor(first, "Roe", id); });
+        } else if (op == 2) {
+            std::string code = courseCode();
+            std::string empID = instructorID();
+            std::vector<std::string> meets = {days[pick(5)], days[pick(5)]};
+            size_t slot = pick(5);
+            std::string start = times[slot], end = times[slot + 1];
+            auto* refInstructor = reference->findInstructorByID(empID);
+            auto* candInstructor = candidate->findInstructorByID(empID);
+            compare("findInstructorByID", refInstructor != nullptr, candInstructor != nullptr);
+            if (refInstructor && candInstructor) {
+                reference->addCourse(code, "Course " + code, *refInstructor, meets, start, end, "Generated.");
+                candidate->addCourse(code, "Course " + code, *candInstructor, meets, start, end, "Generated.");
+            }
+        } else if (op == 3) {
+            std::string id = studentID();
+            compareBoth("removeStudentByNetID", [&](auto& system) { return system.removeStudentByNetID(id); });
+        } else if (op == 4) {
+            std::string id = instructorID();
+            compareBoth("removeInstructorByEmpID", [&](auto& system) { return system.removeInstructorByEmpID(id); });
+        } else if (op == 5) {
+            std::string code = courseCode();
+            compareBoth("removeCourseByCode", [&](auto& system) { return system.removeCourseByCode(code); });
+        } else if (op <= 7) {
+            std::string id = studentID();
+            std::string code = courseCode();
+            auto* refStudent = reference->findStudentByID(id);
+            auto* candStudent = candidate->findStudentByID(id);
+            auto* refCourse = reference->findCourseByID(code);
+            auto* candCourse = candidate->findCourseByID(code);
+            compare("findStudentByID", refStudent != nullptr, candStudent != nullptr);
+            compare("findCourseByID", refCourse != nullptr, candCourse != nullptr);
+            if (failure.empty() && refStudent && refCourse) {
+                compare("clashCheck", reference->clashCheck(*refStudent, *refCourse),
+                        candidate->clashCheck(*candStudent, *candCourse));
+                reference->enrollStudent(*refStudent, *refCourse);
+                candidate->enrollStudent(*candStudent, *candCourse);
+            }
+        } else if (op <= 9) {
+            std::string id = studentID();
+            std::string code = courseCode();
+            both([&](auto& system) { system.dropStudent(id, code); });
+        } else {
+            // Save -> reload: everything was saved as it changed, so a fresh load must see the same state
+            const LMSSnapshot referenceBefore = takeSnapshot(*reference);
+            const LMSSnapshot candidateBefore = takeSnapshot(*candidate);
+            reference.reset(new LMS(referenceDir.path()));
+            candidate.reset(new Candidate(candidateDir.path()));
+            std::string difference = describeDifference(referenceBefore, takeSnapshot(*reference));
+            if (!difference.empty()) {
+                failure = where + "reference changed on reload: " + difference;
+            } else if (!(difference = describeDifference(candidateBefore, takeSnapshot(*candidate))).empty()) {
+                failure = where + "candidate changed on reload: " + difference;
+            }
+        }
+
+        if (failure.empty()) {
+            std::string difference = describeDifference(takeSnapshot(*reference), takeSnapshot(*candidate));
+            if (!difference.empty()) failure = where + difference;
+        }
+    }
+
+    return failure;
+}
+
+// Loads the same data files (bodies as for writeDataFiles) into the reference LMS and a Candidate, then
+// compares what they loaded and how they handle removing every loaded course.
+// Returns an empty string on success, otherwise a description of the first divergence.
+template <class Candidate>
+std::string runLoaderDifferential(const std::vector<std::string>& bodies) {
+    const ScratchDirectory referenceDir("lms_loader_reference");
+    const ScratchDirectory candidateDir("lms_loader_candidate");
+    writeDataFiles(referenceDir.path(), bodies);
+    writeDataFiles(candidateDir.path(), bodies);
+
+    std::unique_ptr<LMS> reference(new LMS(referenceDir.path()));
+    std::unique_ptr<Candidate> candidate(new Candidate(candidateDir.path()));
+    std::string difference = describeDifference(takeSnapshot(*reference), takeSnapshot(*candidate));
+    if (!difference.empty()) {
+        return "after load: " + difference;
+    }
+
+    // Whatever was loaded must also survive the removals the rest of the system relies on
+    while (!reference->getCourses().empty()) {
+        const std::string code = reference->getCourses().front()->getCourseCode();
+        const bool removed = reference->removeCourseByCode(code);
+        if (removed != candidate->removeCourseByCode(code)) {
+            return "removeCourseByCode(" + code + ") returned different results";
+        }
+        if (!removed) break;
+    }
+    difference = describeDifference(takeSnapshot(*reference), takeSnapshot(*candidate));
+    return difference.empty() ? "" : "after removing courses: " + difference;
+}
+
+#endif // LMS_VERIFY_H
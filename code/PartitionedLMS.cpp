@@ -0,0 +1,122 @@
+#include "PartitionedLMS.h"
+
+
+void PartitionedLMS::addShard(const std::string& name, const std::string& dataDirectory) {
+    if (findShard(name)) {
+        std::cout << "A shard named " << name << " already exists." << std::endl;
+        return;
+    }
+    // The shard saves its CSV files there on every mutation, so the directory must be usable
+    const std::filesystem::path directory = dataDirectory.empty() ? "." : dataDirectory;
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::filesystem::path canonicalDirectory;
+    if (!error && std::filesystem::is_directory(directory, error)) {
+        canonicalDirectory = std::filesystem::weakly_canonical(directory, error);
+    }
+    if (error || canonicalDirectory.empty()) {
+        std::cout << "Cannot use " << dataDirectory << " as the data directory of shard " << name << "." << std::endl;
+        return;
+    }
+
+    // Shards lock independently, so two of them saving to the same files would overwrite each other
+    for (const auto& existing : shards) {
+        if (existing->canonicalDirectory == canonicalDirectory) {
+            std::cout << "Shard " << existing->name << " already uses " << dataDirectory
+                      << " as its data directory." << std::endl;
+            return;
+        }
+    }
+
+    std::unique_ptr<Shard> shard(new Shard());
+    shard->name = name;
+    shard->dataDirectory = dataDirectory;
+    shard->canonicalDirectory = std::move(canonicalDirectory);
+    shards.push_back(std::move(shard));
+}
+
+bool PartitionedLMS::hasShard(const std::string& name) const {
+    return findShard(name) != nullptr;
+}
+
+bool PartitionedLMS::isLoaded(const std::string& name) const {
+    Shard* shard = findShard(name);
+    if (!shard) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->lms != nullptr;
+}
+
+std::vector<std::string> PartitionedLMS::getShardNames() const {
+    std::vector<std::string> names;
+    names.reserve(shards.size());
+    for (const auto& shard : shards) {
+        names.push_back(shard->name);
+    }
+    return names;
+}
+
+
+// Helper functions to locate a shard and load it on first access
+PartitionedLMS::Shard* PartitionedLMS::findShard(const std::string& name) const {
+    for (const auto& shard : shards) {
+        if (shard->name == name) {
+            return shard.get();
+        }
+    }
+    return nullptr;
+}
+
+LMS& PartitionedLMS::load(Shard& shard) {
+    if (!shard.lms) {
+        shard.lms.reset(new LMS(shard.dataDirectory));
+    }
+    return *shard.lms;
+}
+
+
+// A student's schedule across all shards they appear in
+std::vector<ShardScheduleEntry> PartitionedLMS::getScheduleAcrossShards(const std::string& studentID) {
+    auto perShard = fanOut<std::vector<ShardScheduleEntry>>([&studentID](LMS& lms) {
+        std::vector<ShardScheduleEntry> entries;
+        Student* student = lms.findStudentByID(studentID);
+        if (!student) {
+            return entries;
+        }
+        for (const std::string& courseCode : student->getEnrolledCourses()) {
+            Course* course = lms.findCourseByID(courseCode);
+            if (course) {
+                entries.push_back({"", course->getCourseCode(), course->getCourseName(),
+                                   course->getCourseInstructor(), course->getDaysOfWeek(),
+                                   course->getStartTime(), course->getEndTime()});
+            }
+        }
+        return entries;
+    });
+
+    // Merge in shard order, tagging each entry with the shard it came from
+    std::vector<ShardScheduleEntry> schedule;
+    for (auto& result : perShard) {
+        for (ShardScheduleEntry& entry : result.second) {
+            entry.shard = result.first;
+            schedule.push_back(std::move(entry));
+        }
+    }
+    return schedule;
+}
+
+// Names of the shards in which a student exists
+std::vector<std::string> PartitionedLMS::findShardsWithStudent(const std::string& studentID) {
+    auto perShard = fanOut<bool>([&studentID](LMS& lms) {
+        return lms.findStudentByID(studentID) != nullptr;
+    });
+
+    std::vector<std::string> names;
+    for (const auto& result : perShard) {
+        if (result.second) {
+            names.push_back(result.first);
+        }
+    }
+    return names;
+}
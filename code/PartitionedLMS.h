@@ -0,0 +1,110 @@
+// PartitionedLMS.h
+
+#ifndef PARTITIONED_LMS_H
+#define PARTITIONED_LMS_H
+
+#include "LMS.h"
+
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// One course on a student's schedule, tagged with the shard (term/campus) it came from
+struct ShardScheduleEntry {
+    std::string shard;
+    std::string courseCode;
+    std::string courseName;
+    std::string instructor;
+    std::vector<std::string> daysOfWeek;
+    std::string startTime;
+    std::string endTime;
+};
+
+// A set of independent LMS instances, one per term or campus, each with its own data directory.
+// A shard is only loaded from its CSV files the first time it is accessed. Each shard has its own
+// mutex, so different shards can be used from different threads at once. Cross-shard queries run
+// on every shard in parallel and merge the results in shard registration order.
+// Register all shards with addShard before sharing the PartitionedLMS between threads.
+class PartitionedLMS {
+public:
+    PartitionedLMS() = default;
+
+    PartitionedLMS(const PartitionedLMS&) = delete;
+    PartitionedLMS& operator=(const PartitionedLMS&) = delete;
+
+    // Register a shard by name with the directory holding its CSV files, creating the directory if
+    // needed; nothing is loaded yet. The shard is rejected if the directory cannot be created or
+    // another shard already uses it.
+    void addShard(const std::string& name, const std::string& dataDirectory);
+
+    // Shard bookkeeping
+    bool hasShard(const std::string& name) const;
+    bool isLoaded(const std::string& name) const;
+    std::vector<std::string> getShardNames() const;
+
+    // Run fn(LMS&) on one shard while holding its lock, loading it on first access.
+    // Returns false if no shard has that name.
+    template <class Fn>
+    bool withShard(const std::string& name, Fn&& fn);
+
+    // Run fn(LMS&) on every shard in parallel and collect (shard name, result) pairs in shard order
+    template <class Result, class Fn>
+    std::vector<std::pair<std::string, Result>> fanOut(Fn fn);
+
+    // A student's schedule across all shards they appear in
+    std::vector<ShardScheduleEntry> getScheduleAcrossShards(const std::string& studentID);
+
+    // Names of the shards in which a student exists
+    std::vector<std::string> findShardsWithStudent(const std::string& studentID);
+
+private:
+    struct Shard {
+        std::string name;
+        std::string dataDirectory;
+        std::filesystem::path canonicalDirectory;
+        mutable std::mutex mutex;
+        std::unique_ptr<LMS> lms;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    // Helper functions to locate a shard and load it on first access (caller holds shard.mutex)
+    Shard* findShard(const std::string& name) const;
+    static LMS& load(Shard& shard);
+};
+
+
+template <class Fn>
+bool PartitionedLMS::withShard(const std::string& name, Fn&& fn) {
+    Shard* shard = findShard(name);
+    if (!shard) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    fn(load(*shard));
+    return true;
+}
+
+template <class Result, class Fn>
+std::vector<std::pair<std::string, Result>> PartitionedLMS::fanOut(Fn fn) {
+    std::vector<std::future<Result>> pending;
+    pending.reserve(shards.size());
+    for (const auto& shard : shards) {
+        Shard* target = shard.get();
+        pending.push_back(std::async(std::launch::async, [target, &fn]() {
+            std::lock_guard<std::mutex> lock(target->mutex);
+            return fn(load(*target));
+        }));
+    }
+
+    std::vector<std::pair<std::string, Result>> results;
+    results.reserve(shards.size());
+    for (size_t i = 0; i < shards.size(); ++i) {
+        results.emplace_back(shards[i]->name, pending[i].get());
+    }
+    return results;
+}
+
+#endif // PARTITIONED_LMS_H